@@ -0,0 +1,34 @@
+#ifndef MINISQL_CACHE_STATS_HPP
+#define MINISQL_CACHE_STATS_HPP
+
+#include <chrono>
+#include <cstdint>
+
+namespace minisql {
+
+/* Cache Stats.
+ * Counters of the page accesses of a database through its buffer pool. A hit
+ * is an access to a page already held in memory and a miss is one which had
+ * to read the page in. */
+struct CacheStats {
+    std::uint64_t hits {0};
+    std::uint64_t misses {0};
+
+    // Return the fraction of accesses that were hits (0 if there were none).
+    double hit_rate() const noexcept {
+        const std::uint64_t accesses = hits + misses;
+        return accesses ? static_cast<double>(hits) / accesses : 0.0;
+    }
+};
+
+/* Warm Up Stats.
+ * The pages read back into the buffer pool when the database was opened, from
+ * those it held when last closed, and how long opening spent reading them. */
+struct WarmUpStats {
+    std::uint64_t pages {0};
+    std::chrono::microseconds duration {0};
+};
+
+} // namespace minisql
+
+#endif // MINISQL_CACHE_STATS_HPP
@@ -4,8 +4,12 @@
 #include <cstddef>
 #include <filesystem>
 #include <string_view>
+#include <vector>
 
+#include <minisql/cache_stats.hpp>
+#include <minisql/field.hpp>
 #include <minisql/minisql_export.hpp>
+#include <minisql/options.hpp>
 #include <minisql/row_set.hpp>
 
 namespace minisql {
@@ -14,7 +18,9 @@ namespace minisql {
  * Provides access to a Database via sql commands. */
 class MINISQL_API Connection {
 public:
-    explicit Connection(const std::filesystem::path& path);
+    explicit Connection(
+        const std::filesystem::path& path, const Options& options = {}
+    );
     ~Connection();
 
     // DDL / DML
@@ -23,6 +29,31 @@ public:
     // SELECT
     RowSet query(std::string_view sql);
 
+    /* Bulk import
+     * Insert rows giving a value for every column of a table (in declared
+     * order, without any rowid), as an INSERT would. Into an empty table the
+     * rows are sorted and the table built from them in one go. Returns the
+     * number of rows inserted. */
+    std::size_t import(
+        std::string_view table, std::vector<std::vector<Field>> rows
+    );
+
+    /* Buffer pool
+     * Resize the buffer pool of the database, shared by every Connection to
+     * it (and every database sharing its pool), to a number of pages or
+     * bytes. Returns the new capacity in pages, clamped to between 1 and
+     * Options::max_cache_capacity. */
+    std::size_t cache_capacity() const;
+    std::size_t set_cache_capacity(std::size_t pages);
+    std::size_t set_cache_size(std::size_t bytes);
+
+    // Return the hits and misses of the database in its buffer pool.
+    CacheStats cache_stats() const;
+
+    /* Return the pages read back into the buffer pool when the database was
+     * opened with Options::warm_up, and how long that took. */
+    WarmUpStats warm_up_stats() const;
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl_;
@@ -0,0 +1,114 @@
+#ifndef MINISQL_OPTIONS_HPP
+#define MINISQL_OPTIONS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace minisql {
+
+// Replacement policy used by the buffer pool to choose pages to evict.
+enum class CachePolicy : std::uint8_t {
+    LRU,        // least recently used, kept in a linked list
+    CLOCK,      // second-chance sweep over a flat array of reference bits
+    TWO_QUEUE,  // 2Q: pages touched once (e.g. by scans) are evicted first
+};
+
+/* Options.
+ * Settings used when a Connection opens a database. They only take effect
+ * when the database is not already open through another Connection. */
+struct Options {
+    /* Read clean pages in-place from a memory mapping of the database file
+     * instead of copying them into the cache (ignored where unsupported). */
+    bool mmap {false};
+
+    /* Read and write batches of pages through io_uring instead of one
+     * syscall per page (ignored where unsupported). */
+    bool async_io {false};
+
+    /* Number of pages of storage preallocated whenever the database file
+     * outgrows its previous allocation (at least 1). */
+    std::uint32_t extent_pages {64};
+
+    /* Open the database file with O_DIRECT so that pages are only buffered by
+     * the engine's own cache and not also by the kernel (ignored where
+     * unsupported). Requires a page size of at least 4096 bytes. */
+    bool direct_io {false};
+
+    /* Size in bytes of the pages of a newly created database: a power of two
+     * from 1024 to 65536. Larger pages hold more rows per leaf and allow wider
+     * tables. Ignored for an existing database, which keeps its page size. */
+    std::size_t page_size {4096};
+
+    /* Number of pages held in memory by the buffer pool. It can be changed
+     * while the database is open with Connection::set_cache_capacity. */
+    std::size_t cache_capacity {2000};
+
+    /* If nonzero, the size in bytes of the buffer pool, overriding
+     * cache_capacity with as many pages as fit (at least one). */
+    std::size_t cache_size {0};
+
+    /* Largest number of pages the buffer pool can be resized to while the
+     * database is open (raised to at least its initial capacity). Room for
+     * them is reserved up front: address space for their pages (where
+     * supported) and a few dozen bytes of bookkeeping each. */
+    std::size_t max_cache_capacity {0};
+
+    // Replacement policy of the buffer pool.
+    CachePolicy cache_policy {CachePolicy::CLOCK};
+
+    /* Hold pages in one buffer pool shared by every database opened with
+     * shared_cache, so that its memory goes to whichever of them needs it
+     * most. The pool is set up by the first of them to be opened, from its
+     * cache options and page size, and lasts while any of them is open. A
+     * database with a different page size, or in memory, gets its own pool. */
+    bool shared_cache {false};
+
+    /* Back the buffer pool with transparent huge pages to reduce TLB misses
+     * (ignored where unsupported). */
+    bool huge_pages {false};
+
+    /* Write dirty pages back from a background thread once more than
+     * dirty_ratio of the buffer pool is dirty, so that reading pages in rarely
+     * has to wait for a dirty page to be written out to make room. Ignored for
+     * an in-memory database. */
+    bool background_writer {false};
+
+    /* Fraction of the buffer pool that may be dirty before the background
+     * writer starts writing pages back. It stops once half that is left. */
+    double dirty_ratio {0.1};
+
+    /* Record which pages are in the buffer pool when the database is closed,
+     * and read them back in (those most recently used first, as far as they
+     * fit) when it is next opened, so that the first queries do not run
+     * against a cold cache. Ignored for an in-memory database. */
+    bool warm_up {false};
+
+    /* Store leaf pages compressed on disk, saving I/O and (where holes can be
+     * punched) disk space for tables with wide padded columns. A database
+     * written with compression must always be opened with it. */
+    bool compress {false};
+
+    /* Keep the database in process memory only, without creating a file at
+     * its path. Also selected by the path ":memory:". The database is lost
+     * once no Connection uses it. */
+    bool in_memory {false};
+
+    /* Maximum number of bytes of pages an in-memory database may grow to. Its
+     * buffer pool grows with it rather than evicting pages. */
+    std::size_t memory_limit {std::size_t{1} << 30};
+
+    /* Maximum number of pages of dropped tables freed before each statement
+     * run with exec, so that DROP TABLE returns without freeing any. With 0
+     * they are only freed by VACUUM. */
+    std::size_t reclaim_pages {256};
+
+    /* Fraction of each page filled when a table is built in one go, by CREATE
+     * TABLE ... AS, Connection::import or an INSERT of many rows into an
+     * empty table. Clamped to between 0.5 and 1; less leaves room for rows
+     * inserted later without splitting pages. */
+    double fill_factor {1.0};
+};
+
+} // namespace minisql
+
+#endif // MINISQL_OPTIONS_HPP
\ No newline at end of file
@@ -1,12 +1,17 @@
 #include "bplus_tree/bplus_tree.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "bplus_tree/internal_node.hpp"
 #include "bplus_tree/leaf_node.hpp"
 #include "bplus_tree/node.hpp"
+#include "byte_io.hpp"
 #include "exceptions/engine_exceptions.hpp"
 #include "frame_manager/cache/frame_view.hpp"
 #include "frame_manager/disk_manager/page_id_t.hpp"
@@ -16,14 +21,41 @@
 
 namespace minisql {
 
+namespace {
+
+/* Return the number of nodes a level of a tree built bottom-up should have to
+ * hold items, each holding about per items but no fewer than min. */
+std::size_t level_size(std::size_t items, std::size_t per, std::size_t min) {
+    const std::size_t nodes = (items + per - 1) / per;
+    if (nodes > 1 && items / nodes < min)
+        return std::max<std::size_t>(items / min, 1);
+    return nodes;
+}
+
+/* Return the number of items held by node k of a level of the given number of
+ * nodes, with items spread as evenly as possible. */
+std::size_t share(std::size_t items, std::size_t nodes, std::size_t k) {
+    return items / nodes + (k < items % nodes);
+}
+
+// Return the node of such a level holding item i.
+std::size_t owner(std::size_t items, std::size_t nodes, std::size_t i) {
+    const std::size_t q = items / nodes, r = items % nodes;
+    if (i < r * (q + 1)) return i / (q + 1);
+    return r + (i - r * (q + 1)) / q;
+}
+
+} // namespace
+
 /* Constructor for B+ Tree.
  * Creates a new root LeafNode if necessary. */
 BPlusTree::BPlusTree(
     FrameManager* fm, key_size_t key_size, slot_size_t slot_size,
-    page_id_t root
-) : fm_{fm}, key_size_{key_size}, slot_size_{slot_size}, root_{root} {
+    page_id_t root, bool keep
+) : fm_{fm}, key_size_{key_size}, slot_size_{slot_size}, root_{root},
+    keep_{keep} {
     if (root_ == nullpid) {
-        LeafNode root_node(fm_->allocate(), key_size_, slot_size_, nullpid);
+        LeafNode root_node(allocate(), key_size_, slot_size_, nullpid);
         root_ = root_node.pid();
     }
 }
@@ -71,9 +103,9 @@ void BPlusTree::insert_into(LeafNode* node, size_t slot, span<std::byte> bytes)
         return;
     }
 
-    // Carry out a split
+    // Carry out a split, placing new_node after node in the file if possible
     LeafNode new_node{
-        fm_->allocate(), key_size_, slot_size_, node->parent(),
+        allocate(node->pid()), key_size_, slot_size_, node->parent(),
         node->next_leaf()
     };
     LeafNode::split(&new_node, node);
@@ -82,7 +114,7 @@ void BPlusTree::insert_into(LeafNode* node, size_t slot, span<std::byte> bytes)
 
     // If node is the root then create a parent
     if (node->is_root()) {
-        InternalNode root{fm_->allocate(), key_size_, nullpid, root_};
+        InternalNode root{allocate(), key_size_, nullpid, root_};
         root_ = root.pid();
         node->set_parent(root_);
         new_node.set_parent(root_);
@@ -164,6 +196,113 @@ void BPlusTree::erase_from(LeafNode* node, size_t slot) {
     }
 }
 
+/* Build the tree bottom-up from slots, sorting them by key first if need be,
+ * with each node filled to fill_factor (clamped to between a half and all) of
+ * its capacity.
+ * The tree must be empty and the keys distinct, otherwise false is returned
+ * and the tree is left as it was.
+ * The slots are spread evenly over as many leaves as they need, so that no
+ * leaf is below its minimum, and each level of internal nodes is built the
+ * same way over the level below. All pages of the tree are allocated as one
+ * extent, a level at a time from the leaves up, so that the leaf chain runs
+ * through adjacent pages and the parent of each node is known when it is
+ * written. As the pages are new they are pinned without being read in. */
+template <typename Key>
+bool BPlusTree::bulk_load(
+    std::vector<span<std::byte>> slots, double fill_factor
+) {
+    {
+        const std::unique_ptr<Node> root = open_node(root_);
+        if (!root->is_leaf() || root->size()) return false;
+    }
+    auto key = [this](span<std::byte> slot) {
+        return byte_io::view<Key>(slot, 0, key_size_);
+    };
+    auto less = [&](span<std::byte> a, span<std::byte> b) {
+        return key(a) < key(b);
+    };
+    if (!std::is_sorted(slots.begin(), slots.end(), less))
+        std::sort(slots.begin(), slots.end(), less);
+    if (std::adjacent_find(
+        slots.begin(), slots.end(),
+        [&](span<std::byte> a, span<std::byte> b) { return !less(a, b); }
+    ) != slots.end())
+        return false;
+    if (slots.empty()) return true;
+
+    // Count the nodes of each level, from the leaves up
+    fill_factor = std::clamp(fill_factor, 0.5, 1.0);
+    const std::size_t page_size = fm_->page_size();
+    const std::size_t leaf_max =
+        (page_size - LeafNodeHeader::SIZE) / slot_size_;
+    const std::size_t internal_max = (page_size - InternalNodeHeader::SIZE) /
+        (key_size_ + sizeof(page_id_t));
+    const std::size_t leaf_min = leaf_max / 2;
+    const std::size_t children_min = internal_max / 2 + internal_max % 2;
+    const std::size_t leaf_per = std::max(
+        static_cast<std::size_t>(leaf_max * fill_factor), leaf_min
+    );
+    const std::size_t children_per = std::max(
+        static_cast<std::size_t>(internal_max * fill_factor) + 1, children_min
+    );
+    std::vector<std::size_t> counts{
+        level_size(slots.size(), leaf_per, leaf_min)
+    };
+    while (counts.back() > 1)
+        counts.push_back(level_size(counts.back(), children_per, children_min));
+
+    std::vector<page_id_t> starts;
+    page_id_t total = 0;
+    for (std::size_t count : counts) {
+        starts.push_back(total);
+        total += static_cast<page_id_t>(count);
+    }
+    fm_->deallocate(root_);
+    const page_id_t first = fm_->allocate_extent(total);
+
+    // Write each level, keeping the last slot under each node for separators
+    std::vector<std::size_t> last;
+    std::size_t items = slots.size();
+    for (std::size_t h = 0; h < counts.size(); h++) {
+        const page_id_t start = first + starts[h];
+        const bool top = h + 1 == counts.size();
+        std::vector<std::size_t> level_last;
+        level_last.reserve(counts[h]);
+        for (std::size_t k = 0, item = 0; k < counts[h]; k++) {
+            const page_id_t pid = start + static_cast<page_id_t>(k);
+            const page_id_t parent = top ? nullpid :
+                first + starts[h + 1] +
+                static_cast<page_id_t>(owner(counts[h], counts[h + 1], k));
+            const std::size_t size = share(items, counts[h], k);
+            if (!h) {
+                LeafNode leaf{
+                    pin_new(pid), key_size_, slot_size_, parent,
+                    k + 1 < counts[h] ? pid + 1 : nullpid
+                };
+                for (std::size_t i = 0; i < size; i++)
+                    leaf.insert(static_cast<size_t>(i), slots[item + i]);
+            }
+            else {
+                const page_id_t below = first + starts[h - 1];
+                InternalNode node{
+                    pin_new(pid), key_size_, parent,
+                    below + static_cast<page_id_t>(item)
+                };
+                for (std::size_t i = 1; i < size; i++) node.insert<Key>(
+                    static_cast<size_t>(i - 1), key(slots[last[item + i - 1]]),
+                    below + static_cast<page_id_t>(item + i)
+                );
+            }
+            item += size;
+            level_last.push_back(h ? last[item - 1] : item - 1);
+        }
+        last = std::move(level_last);
+        items = counts[h];
+    }
+    root_ = first + starts.back();
+    return true;
+}
+
 /* Copy the given key and pid to the given slot in node.
  * Shifts all slots >= slot to the right by 1.
  * If node has the maximum number of slots and requires splitting the tree
@@ -179,8 +318,8 @@ void BPlusTree::insert_into(
         return;
     }
 
-    // Carry out a split
-    InternalNode new_node{fm_->allocate(), key_size_, node->parent()};
+    // Carry out a split, placing new_node after node in the file if possible
+    InternalNode new_node{allocate(node->pid()), key_size_, node->parent()};
     const Key separator = InternalNode::split<Key>(&new_node, node.get());
     if (slot <= node->size()) node->insert<Key>(slot, key, pid);
     else new_node.insert<Key>(slot - node->size() - 1, key, pid);
@@ -192,7 +331,7 @@ void BPlusTree::insert_into(
 
     // If node is the root then create a parent
     if (node->is_root()) {
-        InternalNode root{fm_->allocate(), key_size_, nullpid, root_};
+        InternalNode root{allocate(), key_size_, nullpid, root_};
         root_ = root.pid();
         node->set_parent(root_);
         new_node.set_parent(root_);
@@ -290,22 +429,43 @@ void BPlusTree::erase_from(std::unique_ptr<InternalNode> node, size_t slot) {
     }
 }
 
-/* Return the LeafNode corresponding to the given page_id_t.
+/* Return the LeafNode corresponding to the given page_id_t, pinned through
+ * ring if given.
  * Throws a MagicException if the page corresponding to the page_id_t does not
  * have a LEAF_NODE magic. */
-std::unique_ptr<LeafNode> BPlusTree::open_leaf(page_id_t pid) const {
-    FrameView fv = fm_->pin(pid);
+std::unique_ptr<LeafNode> BPlusTree::open_leaf(
+    page_id_t pid, ScanRing* ring
+) const {
+    FrameView fv = pin(pid, ring);
     Magic magic = fv.view<Magic>(NodeHeader::MAGIC_OFFSET);
     if (magic == Magic::LEAF_NODE)
         return std::make_unique<LeafNode>(std::move(fv));
     throw MagicException(magic);
 }
 
+/* Return the page_id_t's of up to n LeafNodes following leaf within its parent,
+ * in key order.
+ * Returns none if leaf is the root. */
+std::vector<page_id_t> BPlusTree::sibling_leaves(
+    const LeafNode* leaf, std::size_t n
+) const {
+    std::vector<page_id_t> pids;
+    if (leaf->is_root()) return pids;
+    std::unique_ptr<InternalNode> parent = open_internal(leaf->parent());
+    size_t slot = static_cast<size_t>(-1);
+    while (slot != parent->size() && parent->child(slot) != leaf->pid())
+        slot++;
+    if (slot == parent->size()) return pids;
+    for (slot++; slot != parent->size() && pids.size() < n; slot++)
+        pids.push_back(parent->child(slot));
+    return pids;
+}
+
 /* Return the InternalNode corresponding to the given page_id_t.
  * Throws a MagicException if the page corresponding to the page_id_t does not
  * have an INTERNAL_NODE magic. */
 std::unique_ptr<InternalNode> BPlusTree::open_internal(page_id_t pid) const {
-    FrameView fv = fm_->pin(pid);
+    FrameView fv = pin(pid);
     Magic magic = fv.view<Magic>(NodeHeader::MAGIC_OFFSET);
     if (magic == Magic::INTERNAL_NODE)
         return std::make_unique<InternalNode>(std::move(fv));
@@ -317,7 +477,7 @@ std::unique_ptr<InternalNode> BPlusTree::open_internal(page_id_t pid) const {
  * Throws a MagicException if the page corresponding to the page_id_t does not
  * have a valid node magic. */
 std::unique_ptr<Node> BPlusTree::open_node(page_id_t pid) const {
-    FrameView fv = fm_->pin(pid);
+    FrameView fv = pin(pid);
     Magic magic = fv.view<Magic>(NodeHeader::MAGIC_OFFSET);
     switch (magic) {
         case Magic::INTERNAL_NODE:
@@ -329,15 +489,94 @@ std::unique_ptr<Node> BPlusTree::open_node(page_id_t pid) const {
     }
 }
 
-// Destroy node and the entire sub-tree it contains.
-void BPlusTree::destroy(std::unique_ptr<Node> node) {
-    if (!node->is_leaf()) {
-        InternalNode* internal = dynamic_cast<InternalNode*>(node.get());
-        destroy(open_node(internal->child(-1)));
-        for (size_t slot = 0; slot < internal->size(); slot++)
-            destroy(open_node(internal->child(slot)));
+/* Pin the page at pid through ring if given, marking it to be kept in the
+ * cache if keep_ is set. */
+FrameView BPlusTree::pin(page_id_t pid, ScanRing* ring) const {
+    FrameView fv = fm_->pin(pid, ring);
+    if (keep_) fv.keep();
+    return fv;
+}
+
+/* Pin the newly allocated page at pid without reading it in, marking it to be
+ * kept in the cache if keep_ is set. */
+FrameView BPlusTree::pin_new(page_id_t pid) const {
+    FrameView fv = fm_->pin_new(pid);
+    if (keep_) fv.keep();
+    return fv;
+}
+
+/* Allocate a page, near the page at near if given, marking it to be kept in
+ * the cache if keep_ is set. */
+FrameView BPlusTree::allocate(page_id_t near) const {
+    FrameView fv = fm_->allocate(near);
+    if (keep_) fv.keep();
+    return fv;
+}
+
+// Return the height of the tree, reading the pages down its left edge.
+std::uint8_t BPlusTree::height() const {
+    std::uint8_t height = 0;
+    for (std::unique_ptr<Node> node = open_node(root_); !node->is_leaf();) {
+        node = open_node(dynamic_cast<InternalNode*>(node.get())->child(-1));
+        height++;
+    }
+    return height;
+}
+
+/* Free every page of the tree at once.
+ * As every leaf is at the same depth, only the pages down the left edge of
+ * the tree and then the internal nodes are read (see take_subtrees), and the
+ * leaves are found from their parents. */
+void BPlusTree::destroy() {
+    std::vector<SubTree> pending{{root_, height()}};
+    free_subtrees(fm_, pending, std::numeric_limits<std::size_t>::max());
+}
+
+/* Free up to budget pages (at least one, if any are pending) of the SubTrees
+ * on the pending stack through fm, and return how many were freed. The pages
+ * are freed together once all have been found (see take_subtrees). */
+std::size_t BPlusTree::free_subtrees(
+    FrameManager* fm, std::vector<SubTree>& pending, std::size_t budget
+) {
+    std::vector<page_id_t> pids = take_subtrees(fm, pending, budget);
+    fm->deallocate(pids);
+    return pids.size();
+}
+
+/* Pop up to budget pages (at least one, if any are pending) of the SubTrees
+ * on the pending stack, read through fm, and return their page_id_t's for
+ * the caller to free.
+ * SubTrees are popped in batches of as many as may still be taken, and the
+ * internal nodes of a batch are prefetched together before any is read to
+ * push its children, so that the trees are read about a level at a time and
+ * leaves are never read. */
+std::vector<page_id_t> BPlusTree::take_subtrees(
+    FrameManager* fm, std::vector<SubTree>& pending, std::size_t budget
+) {
+    const std::size_t limit = std::max<std::size_t>(budget, 1);
+    std::vector<page_id_t> pids;
+    while (!pending.empty() && pids.size() < limit) {
+        const std::size_t n = std::min(limit - pids.size(), pending.size());
+        const std::vector<SubTree> batch(pending.end() - n, pending.end());
+        pending.resize(pending.size() - n);
+
+        std::vector<page_id_t> internal;
+        for (const SubTree& sub_tree : batch)
+            if (sub_tree.height) internal.push_back(sub_tree.root);
+        fm->prefetch(internal);
+
+        for (const SubTree& sub_tree : batch) {
+            if (sub_tree.height) {
+                const InternalNode node{fm->pin(sub_tree.root)};
+                const std::uint8_t height = sub_tree.height - 1;
+                pending.push_back({node.child(-1), height});
+                for (size_t slot = 0; slot < node.size(); slot++)
+                    pending.push_back({node.child(slot), height});
+            }
+            pids.push_back(sub_tree.root);
+        }
     }
-    fm_->deallocate(node->pid());
+    return pids;
 }
 
 // Explicitly instantiate templated methods for all Field types.
@@ -350,6 +589,9 @@ void BPlusTree::destroy(std::unique_ptr<Node> node) {
         LeafNode*, size_t, span<std::byte> bytes                              \
     );                                                                        \
     template void BPlusTree::erase_from<T>(LeafNode*, size_t);                \
+    template bool BPlusTree::bulk_load<T>(                                    \
+        std::vector<span<std::byte>>, double                                  \
+    );                                                                        \
     template void BPlusTree::insert_into<T>(                                  \
         std::unique_ptr<InternalNode>, size_t, const T&, page_id_t            \
     );                                                                        \
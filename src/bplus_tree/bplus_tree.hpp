@@ -2,7 +2,9 @@
 #define MINISQL_BPLUS_TREE_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "bplus_tree/internal_node.hpp"
 #include "bplus_tree/leaf_node.hpp"
@@ -15,7 +17,10 @@ namespace minisql {
 
 /* B+ Tree
  * Manages a tree structure of InternalNodes and LeafNodes throughout inserts
- * into and erases from LeafNodes for efficient key searching. */
+ * into and erases from LeafNodes for efficient key searching.
+ * An empty tree can instead be built bottom-up from many slots at once (see
+ * bulk_load).
+ * If keep is set then the pages of its nodes are kept in the cache. */
 class BPlusTree {
 public:
     using key_size_t = Node::key_size_t;
@@ -24,7 +29,7 @@ public:
 
     BPlusTree(
         FrameManager* fm, key_size_t key_size, slot_size_t slot_size,
-        page_id_t root = nullpid
+        page_id_t root = nullpid, bool keep = false
     );
 
     template <typename Key>
@@ -37,17 +42,46 @@ public:
     template <typename Key>
     void erase_from(LeafNode* node, size_t slot);
 
-    std::unique_ptr<LeafNode> open_leaf(page_id_t pid) const;
+    template <typename Key>
+    bool bulk_load(std::vector<span<std::byte>> slots, double fill_factor);
 
-    page_id_t root() const noexcept { return root_; }
+    std::unique_ptr<LeafNode> open_leaf(
+        page_id_t pid, ScanRing* ring = nullptr
+    ) const;
+    std::vector<page_id_t> sibling_leaves(
+        const LeafNode* leaf, std::size_t n
+    ) const;
 
-    void destroy() { destroy(open_node(root_)); }
+    page_id_t root() const noexcept { return root_; }
+    FrameManager* frame_manager() const noexcept { return fm_; }
+
+    /* SubTree
+     * The root page and height (0 for a leaf) of a sub-tree still to be freed
+     * by free_subtrees or take_subtrees. */
+    struct SubTree {
+        page_id_t root;
+        std::uint8_t height;
+    };
+
+    std::uint8_t height() const;
+    void destroy();
+    static std::size_t free_subtrees(
+        FrameManager* fm, std::vector<SubTree>& pending, std::size_t budget
+    );
+    static std::vector<page_id_t> take_subtrees(
+        FrameManager* fm, std::vector<SubTree>& pending, std::size_t budget
+    );
 
 private:
     FrameManager* fm_;
     key_size_t key_size_;
     slot_size_t slot_size_;
     page_id_t root_;
+    bool keep_;
+
+    FrameView pin(page_id_t pid, ScanRing* ring = nullptr) const;
+    FrameView pin_new(page_id_t pid) const;
+    FrameView allocate(page_id_t near = nullpid) const;
 
     template <typename Key>
     void insert_into(
@@ -60,8 +94,6 @@ private:
     std::unique_ptr<InternalNode> open_internal(page_id_t pid) const;
     std::unique_ptr<Node> open_node(page_id_t pid) const;
 
-    void destroy(std::unique_ptr<Node> node);
-
     template <typename T>
     friend struct Wrapper;
 };
@@ -78,6 +110,9 @@ private:
         LeafNode*, size_t, span<std::byte> bytes                              \
     );                                                                        \
     extern template void BPlusTree::erase_from<T>(LeafNode*, size_t);         \
+    extern template bool BPlusTree::bulk_load<T>(                             \
+        std::vector<span<std::byte>>, double                                  \
+    );                                                                        \
     extern template void BPlusTree::insert_into<T>(                           \
         std::unique_ptr<InternalNode>, size_t, const T&, page_id_t            \
     );                                                                        \
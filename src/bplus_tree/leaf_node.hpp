@@ -36,8 +36,13 @@ public:
     span<std::byte> slot(size_t slot) const {
         return span{fv_.data() + offset(slot), slot_size_};
     }
+    span<std::byte> mutable_slot(size_t slot) {
+        return span{fv_.mutable_data() + offset(slot), slot_size_};
+    }
     void set_slot(size_t slot, span<std::byte> bytes) {
-        std::memcpy(fv_.data() + offset(slot), bytes.data(), slot_size_);
+        std::memcpy(
+            fv_.mutable_data() + offset(slot), bytes.data(), slot_size_
+        );
     }
 
     void insert(size_t slot, span<std::byte> bytes) {
@@ -1,5 +1,6 @@
 #include "bplus_tree/node.hpp"
 
+#include <cstddef>
 #include <cstring>
 #include <utility>
 
@@ -35,9 +36,10 @@ Node::Node(FrameView&& fv) : fv_{std::move(fv)} {
  * Adds steps to size_ to reflect the space added/removed. */
 void Node::shift(size_t start_slot, int steps) {
     if (!steps || start_slot > size_) return;
+    std::byte* data = fv_.mutable_data();
     std::memmove(
-        fv_.data() + offset(start_slot + steps),
-        fv_.data() + offset(start_slot), (size_ - start_slot)  * slot_size_
+        data + offset(start_slot + steps),
+        data + offset(start_slot), (size_ - start_slot)  * slot_size_
     );
     set_size(size_ + steps);
 }
@@ -58,7 +60,7 @@ void Node::splice_back_to_front(Node* dst, Node* src, size_t count) {
     if (count > src->size_) count = src->size_;
     dst->shift(0, count);
     std::memcpy(
-        dst->fv_.data() + dst->offset(0),
+        dst->fv_.mutable_data() + dst->offset(0),
         src->fv_.data() + src->offset(src->size_ - count),
         count * src->slot_size_
     );
@@ -71,7 +73,7 @@ void Node::splice_front_to_back(Node* dst, Node* src, size_t count) {
     assert_compatibility(dst, src);
     if (count > src->size_) count = src->size_;
     std::memcpy(
-        dst->fv_.data() + dst->offset(dst->size_),
+        dst->fv_.mutable_data() + dst->offset(dst->size_),
         src->fv_.data() + src->offset(0),
         count * src->slot_size_
     );
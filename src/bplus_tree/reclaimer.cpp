@@ -0,0 +1,103 @@
+#include "bplus_tree/reclaimer.hpp"
+
+#include <cstddef>
+#include <vector>
+
+#include "bplus_tree/bplus_tree.hpp"
+#include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/cache/frame_view.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "headers.hpp"
+
+namespace minisql {
+
+// Add the pages of bp_tree to be reclaimed.
+void Reclaimer::add(const BPlusTree& bp_tree) {
+    stack_.push_back({bp_tree.root(), bp_tree.height()});
+}
+
+/* Free up to budget pages (at least one, if any are pending) and return how
+ * many were freed. */
+std::size_t Reclaimer::step(std::size_t budget) {
+    return BPlusTree::free_subtrees(fm_, stack_, budget);
+}
+
+/* Remove up to budget pages (at least one, if any are pending) as by step, but
+ * return them for the caller to free instead of freeing them. */
+std::vector<page_id_t> Reclaimer::take_pages(std::size_t budget) {
+    return BPlusTree::take_subtrees(fm_, stack_, budget);
+}
+
+/* Write the pending Entries to a chain of newly allocated pages and return the
+ * page_id_t of the first, or nullpid if there are none. The chain replaces
+ * the one whose pages are kept, which must first be taken with take_blocks. */
+page_id_t Reclaimer::save() {
+    using count_t = ReclaimListBlockHeader::count_t;
+    using height_t = ReclaimListBlockHeader::height_t;
+    const std::size_t per_block =
+        (fm_->page_size() - ReclaimListBlockHeader::SIZE) /
+        ReclaimListBlockHeader::ENTRY_SIZE;
+
+    // Fill the blocks from the last, so that each knows the next
+    page_id_t next_block = nullpid;
+    blocks_.clear();
+    for (std::size_t end = stack_.size(); end;) {
+        const std::size_t begin = (end - 1) / per_block * per_block;
+        FrameView fv = fm_->allocate();
+        fv.write<Magic>(
+            ReclaimListBlockHeader::MAGIC_OFFSET, Magic::RECLAIM_LIST_BLOCK
+        );
+        fv.write<count_t>(
+            ReclaimListBlockHeader::COUNT_OFFSET,
+            static_cast<count_t>(end - begin)
+        );
+        fv.write<page_id_t>(
+            ReclaimListBlockHeader::NEXT_BLOCK_OFFSET, next_block
+        );
+        for (std::size_t i = begin; i < end; i++) {
+            const std::size_t offset = ReclaimListBlockHeader::SIZE +
+                (i - begin) * ReclaimListBlockHeader::ENTRY_SIZE;
+            fv.write<page_id_t>(offset, stack_[i].root);
+            fv.write<height_t>(offset + sizeof(page_id_t), stack_[i].height);
+        }
+        next_block = fv.pid();
+        blocks_.push_back(next_block);
+        end = begin;
+    }
+    return next_block;
+}
+
+/* Push the Entries stored in the chain starting at first_block, in the order
+ * they were saved, keeping the pages of the chain. Throws a MagicException if
+ * a page of the chain is not a reclaim list block. */
+void Reclaimer::load(page_id_t first_block) {
+    using count_t = ReclaimListBlockHeader::count_t;
+    using height_t = ReclaimListBlockHeader::height_t;
+    for (page_id_t pid = first_block; pid != nullpid;) {
+        FrameView fv = fm_->pin(pid);
+        const Magic magic =
+            fv.view<Magic>(ReclaimListBlockHeader::MAGIC_OFFSET);
+        if (magic != Magic::RECLAIM_LIST_BLOCK) throw MagicException(magic);
+        const count_t count =
+            fv.view<count_t>(ReclaimListBlockHeader::COUNT_OFFSET);
+        for (count_t i = 0; i < count; i++) {
+            const std::size_t offset = ReclaimListBlockHeader::SIZE +
+                i * ReclaimListBlockHeader::ENTRY_SIZE;
+            stack_.push_back({
+                fv.view<page_id_t>(offset),
+                fv.view<height_t>(offset + sizeof(page_id_t))
+            });
+        }
+        blocks_.push_back(pid);
+        pid = fv.view<page_id_t>(ReclaimListBlockHeader::NEXT_BLOCK_OFFSET);
+    }
+}
+
+// Return the pages of the chain last saved or loaded, forgetting them.
+std::vector<page_id_t> Reclaimer::take_blocks() {
+    std::vector<page_id_t> blocks;
+    blocks.swap(blocks_);
+    return blocks;
+}
+
+} // namespace minisql
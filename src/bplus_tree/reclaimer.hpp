@@ -0,0 +1,51 @@
+#ifndef MINISQL_RECLAIMER_HPP
+#define MINISQL_RECLAIMER_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "bplus_tree/bplus_tree.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/frame_manager.hpp"
+
+namespace minisql {
+
+/* Reclaimer
+ * Frees the pages of BPlusTrees that are no longer needed a bounded number at
+ * a time, so that dropping a table need not wait for all of its pages to be
+ * freed.
+ * Pending pages are held on a stack of Entries, each the root of a sub-tree
+ * and its height. A step frees as many of them as allowed through
+ * BPlusTree::free_subtrees, so that leaves are freed without ever being
+ * read.
+ * The stack can be saved to and loaded from a chain of pages each made up of
+ * a ReclaimListBlockHeader followed by as many Entries as fit, so that
+ * reclamation resumes after the database is reopened. The pages of the chain
+ * last saved or loaded are kept until taken with take_blocks, for the caller
+ * to free once a newer chain is recorded in its place. */
+class Reclaimer {
+public:
+    using Entry = BPlusTree::SubTree;
+
+    explicit Reclaimer(FrameManager* fm) : fm_{fm} {}
+
+    void add(const BPlusTree& bp_tree);
+    std::size_t step(std::size_t budget);
+    std::vector<page_id_t> take_pages(std::size_t budget);
+
+    page_id_t save();
+    void load(page_id_t first_block);
+    std::vector<page_id_t> take_blocks();
+
+    bool done() const noexcept { return stack_.empty(); }
+    const std::vector<Entry>& entries() const noexcept { return stack_; }
+
+private:
+    FrameManager* fm_;
+    std::vector<Entry> stack_;
+    std::vector<page_id_t> blocks_;
+};
+
+} // namespace minisql
+
+#endif // MINISQL_RECLAIMER_HPP
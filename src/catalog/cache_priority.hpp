@@ -0,0 +1,14 @@
+#ifndef MINISQL_CACHE_PRIORITY_HPP
+#define MINISQL_CACHE_PRIORITY_HPP
+
+#include <cstdint>
+
+namespace minisql {
+
+/* Enum detailing how the pages of a Table are cached: NORMAL pages are evicted
+ * like any other, while KEEP pages stay resident once read (see BufferPool). */
+enum class CachePriority : std::uint8_t { NORMAL, KEEP };
+
+} // namespace minisql
+
+#endif // MINISQL_CACHE_PRIORITY_HPP
@@ -1,10 +1,12 @@
 #ifndef MINISQL_CATALOG_HPP
 #define MINISQL_CATALOG_HPP
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <unordered_map>
 
+#include "catalog/cache_priority.hpp"
 #include "catalog/table.hpp"
 #include "frame_manager/disk_manager/page_id_t.hpp"
 #include "row/schema.hpp"
@@ -19,11 +21,22 @@ public:
 
     virtual void add_table(
         const std::string& name, std::unique_ptr<Schema> schema,
-        page_id_t root = nullpid, rowid_t next_rowid = 0
+        page_id_t root = nullpid, rowid_t next_rowid = 0,
+        CachePriority cache_priority = CachePriority::NORMAL
     ) = 0;
 
     virtual void erase_table(const std::string& name) = 0;
 
+    /* Free up to budget pages of erased Tables whose pages are still to be
+     * reclaimed, returning how many were freed (0 once none are left). */
+    virtual std::size_t reclaim(std::size_t budget) = 0;
+
+    // Return the size of the pages Tables are stored in.
+    virtual std::size_t page_size() const = 0;
+
+    // Return the fraction of each node filled when a Table is bulk loaded.
+    virtual double fill_factor() const = 0;
+
     Table* find_table(const std::string& name) {
         auto it = tables_.find(name);
         if (it != tables_.end()) return &(it->second);
@@ -5,6 +5,7 @@
 #include <memory>
 
 #include "bplus_tree/bplus_tree.hpp"
+#include "catalog/cache_priority.hpp"
 #include "row/schema.hpp"
 
 namespace minisql {
@@ -14,12 +15,14 @@ using rowid_t = std::uint32_t;
 struct Table {
     Table(
         std::unique_ptr<BPlusTree> bp_tree, std::unique_ptr<Schema> schema,
-        rowid_t next_rowid
-    ) : bp_tree{std::move(bp_tree)}, schema{std::move(schema)}, next_rowid{next_rowid} {}
+        rowid_t next_rowid, CachePriority cache_priority = CachePriority::NORMAL
+    ) : bp_tree{std::move(bp_tree)}, schema{std::move(schema)}, next_rowid{next_rowid},
+        cache_priority{cache_priority} {}
     
     std::unique_ptr<BPlusTree> bp_tree;
     const std::unique_ptr<Schema> schema;
     rowid_t next_rowid;
+    const CachePriority cache_priority;
 };
 
 } // namespace minisql
@@ -0,0 +1,153 @@
+#include "compression/lz.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "exceptions/engine_exceptions.hpp"
+
+namespace minisql::lz {
+
+namespace {
+
+constexpr unsigned HASH_BITS = 12;
+
+// Hash the MIN_MATCH bytes starting from p.
+std::uint32_t hash(const std::byte* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+/* Writer over a bounded output buffer.
+ * Once the buffer would overflow every further write is dropped and ok() is
+ * false. */
+class Writer {
+public:
+    Writer(std::byte* dst, std::size_t capacity)
+        : dst_{dst}, capacity_{capacity} {}
+
+    void byte(std::size_t v) {
+        if (size_ >= capacity_) { ok_ = false; return; }
+        dst_[size_++] = static_cast<std::byte>(v);
+    }
+
+    void bytes(const std::byte* src, std::size_t n) {
+        if (n > capacity_ - size_) { ok_ = false; return; }
+        std::memcpy(dst_ + size_, src, n);
+        size_ += n;
+    }
+
+    // Write the part of a length beyond the 15 held in a token nibble.
+    void extension(std::size_t n) {
+        for (; n >= 255; n -= 255) byte(255);
+        byte(n);
+    }
+
+    bool ok() const noexcept { return ok_; }
+    std::size_t size() const noexcept { return size_; }
+
+private:
+    std::byte* dst_;
+    std::size_t capacity_;
+    std::size_t size_ {0};
+    bool ok_ {true};
+};
+
+// Write a token of the given literals followed by a match (if match_length).
+void token(
+    Writer& out, const std::byte* literals, std::size_t literal_count,
+    std::size_t offset, std::size_t match_length
+) {
+    const std::size_t match_code = match_length ? match_length - MIN_MATCH : 0;
+    out.byte(
+        (literal_count < 15 ? literal_count : 15) << 4 |
+        (match_code < 15 ? match_code : 15)
+    );
+    if (literal_count >= 15) out.extension(literal_count - 15);
+    out.bytes(literals, literal_count);
+    if (!match_length) return;
+    out.byte(offset & 0xFF);
+    out.byte(offset >> 8);
+    if (match_code >= 15) out.extension(match_code - 15);
+}
+
+/* Read a length whose token nibble was 15 from src at pos.
+ * Throws a CompressionException if src ends first. */
+std::size_t extension(const std::byte* src, std::size_t size, std::size_t& pos)
+{
+    std::size_t n = 0, b;
+    do {
+        if (pos >= size) throw CompressionException("truncated length");
+        b = static_cast<std::size_t>(src[pos++]);
+        n += b;
+    } while (b == 255);
+    return n;
+}
+
+} // namespace
+
+/* Compress the size bytes of src into dst.
+ * Returns the compressed size, or 0 if it would exceed capacity. */
+std::size_t compress(
+    const std::byte* src, std::size_t size, std::byte* dst,
+    std::size_t capacity
+) {
+    Writer out{dst, capacity};
+    std::vector<std::uint32_t> table(std::size_t{1} << HASH_BITS, UINT32_MAX);
+    std::size_t pos = 0, anchor = 0;
+    while (size >= MIN_MATCH && pos <= size - MIN_MATCH && out.ok()) {
+        const std::uint32_t h = hash(src + pos);
+        const std::uint32_t candidate = table[h];
+        table[h] = static_cast<std::uint32_t>(pos);
+        if (candidate == UINT32_MAX || pos - candidate > MAX_OFFSET ||
+            std::memcmp(src + candidate, src + pos, MIN_MATCH)) {
+            pos++;
+            continue;
+        }
+        std::size_t length = MIN_MATCH;
+        while (pos + length < size &&
+            src[candidate + length] == src[pos + length]) length++;
+        token(out, src + anchor, pos - anchor, pos - candidate, length);
+        pos += length;
+        anchor = pos;
+    }
+    token(out, src + anchor, size - anchor, 0, 0);
+    return out.ok() ? out.size() : 0;
+}
+
+/* Decompress the size bytes of src into exactly dst_size bytes of dst.
+ * Throws a CompressionException if src is malformed or does not decompress
+ * to dst_size bytes. */
+void decompress(
+    const std::byte* src, std::size_t size, std::byte* dst,
+    std::size_t dst_size
+) {
+    std::size_t in = 0, out = 0;
+    while (in < size) {
+        const std::size_t t = static_cast<std::size_t>(src[in++]);
+        std::size_t literal_count = t >> 4;
+        if (literal_count == 15) literal_count += extension(src, size, in);
+        if (literal_count > size - in || literal_count > dst_size - out)
+            throw CompressionException("literals overrun");
+        std::memcpy(dst + out, src + in, literal_count);
+        in += literal_count;
+        out += literal_count;
+        if (in == size) break;
+
+        if (size - in < 2) throw CompressionException("truncated offset");
+        const std::size_t offset = static_cast<std::size_t>(src[in]) |
+            static_cast<std::size_t>(src[in + 1]) << 8;
+        in += 2;
+        std::size_t length = (t & 0xF) + MIN_MATCH;
+        if ((t & 0xF) == 15) length += extension(src, size, in);
+        if (!offset || offset > out || length > dst_size - out)
+            throw CompressionException("match overrun");
+        for (std::size_t i = 0; i < length; i++, out++)
+            dst[out] = dst[out - offset];
+    }
+    if (out != dst_size) throw CompressionException("size mismatch");
+}
+
+} // namespace minisql::lz
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef MINISQL_LZ_HPP
+#define MINISQL_LZ_HPP
+
+#include <cstddef>
+
+namespace minisql {
+
+/* Namespace exposing a small LZ77 codec for pages.
+ * The format is a sequence of tokens, each a run of literals followed by a
+ * back-reference of at least MIN_MATCH bytes (the final token has literals
+ * only). A token starts with a byte holding the literal count in its high
+ * nibble and the match length minus MIN_MATCH in its low nibble, either of
+ * which is extended by further bytes when it is 15. The literals follow, then
+ * a 2-byte little-endian offset to the start of the match. */
+namespace lz {
+
+inline constexpr std::size_t MIN_MATCH = 4;
+inline constexpr std::size_t MAX_OFFSET = 0xFFFF;
+
+std::size_t compress(
+    const std::byte* src, std::size_t size, std::byte* dst,
+    std::size_t capacity
+);
+void decompress(
+    const std::byte* src, std::size_t size, std::byte* dst,
+    std::size_t dst_size
+);
+
+} // namespace lz
+
+} // namespace minisql
+
+#endif // MINISQL_LZ_HPP
\ No newline at end of file
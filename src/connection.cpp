@@ -3,10 +3,16 @@
 #include <cstddef>
 #include <filesystem>
 #include <memory>
+#include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "engine/database_handle.hpp"
 #include "engine/engine.hpp"
+#include "minisql/cache_stats.hpp"
+#include "minisql/field.hpp"
+#include "minisql/options.hpp"
 #include "minisql/row_set.hpp"
 
 namespace minisql {
@@ -14,23 +20,58 @@ namespace minisql {
 // Implementation of Connection methods.
 class Connection::Impl {
 public:
-    explicit Impl(const std::filesystem::path& path)
-        : dbh_{engine_.open_database(path)} {}
+    Impl(const std::filesystem::path& path, const Options& options)
+        : dbh_{engine_.open_database(path, options)} {}
 
     std::size_t exec(std::string_view sql) { return engine_.exec(sql, *dbh_); }
 
     RowSet query(std::string_view sql) { return engine_.query(sql, *dbh_); }
 
+    std::size_t import(
+        std::string_view table, std::vector<std::vector<Field>> rows
+    ) {
+        return engine_.import(std::string{table}, std::move(rows), *dbh_);
+    }
+
+    std::size_t cache_capacity() { return dbh_->cache_capacity(); }
+    std::size_t set_cache_capacity(std::size_t pages) {
+        return dbh_->set_cache_capacity(pages);
+    }
+    std::size_t set_cache_size(std::size_t bytes) {
+        return dbh_->set_cache_size(bytes);
+    }
+    CacheStats cache_stats() { return dbh_->cache_stats(); }
+    WarmUpStats warm_up_stats() { return dbh_->warm_up_stats(); }
+
 private:
     inline static Engine engine_;
     DatabaseHandle dbh_;
 };
 
 // Forward Connection methods to Impl
-Connection::Connection(const std::filesystem::path& path)
-    : impl_{std::make_unique<Impl>(path)} {}
+Connection::Connection(
+    const std::filesystem::path& path, const Options& options
+) : impl_{std::make_unique<Impl>(path, options)} {}
 Connection::~Connection() {}
 std::size_t Connection::exec(std::string_view sql) { return impl_->exec(sql); }
 RowSet Connection::query(std::string_view sql) { return impl_->query(sql); }
+std::size_t Connection::import(
+    std::string_view table, std::vector<std::vector<Field>> rows
+) {
+    return impl_->import(table, std::move(rows));
+}
+std::size_t Connection::cache_capacity() const {
+    return impl_->cache_capacity();
+}
+std::size_t Connection::set_cache_capacity(std::size_t pages) {
+    return impl_->set_cache_capacity(pages);
+}
+std::size_t Connection::set_cache_size(std::size_t bytes) {
+    return impl_->set_cache_size(bytes);
+}
+CacheStats Connection::cache_stats() const { return impl_->cache_stats(); }
+WarmUpStats Connection::warm_up_stats() const {
+    return impl_->warm_up_stats();
+}
 
 } // namespace minisql
\ No newline at end of file
@@ -1,10 +1,16 @@
 #include "cursor.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "bplus_tree/bplus_tree.hpp"
 #include "exceptions/engine_exceptions.hpp"
 #include "field/type.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/frame_manager.hpp"
 #include "minisql/field.hpp"
 #include "minisql/varchar.hpp"
 #include "row/row_view.hpp"
@@ -13,23 +19,27 @@
 namespace minisql {
 
 // Intitialise the Cursor to read slots from bp_tree using schema.
-Cursor::Cursor(BPlusTree* bp_tree, const Schema& schema)
-    : bp_tree_{bp_tree}, schema_{std::make_shared<Schema>(schema)} {
+Cursor::Cursor(BPlusTree* bp_tree, const Schema& schema, bool writable)
+    : bp_tree_{bp_tree}, schema_{std::make_shared<Schema>(schema)},
+    writable_{writable} {
     switch (schema_->primary().type) {
         case FieldType::INT:
             seek_ = &Cursor::seek__<int>;
             insert_ = &Cursor::insert__<int>;
             erase_ = &Cursor::erase__<int>;
+            load_ = &Cursor::load__<int>;
             break;
         case FieldType::REAL:
             seek_ = &Cursor::seek__<double>;
             insert_ = &Cursor::insert__<double>;
             erase_ = &Cursor::erase__<double>;
+            load_ = &Cursor::load__<double>;
             break;
         case FieldType::TEXT:
             seek_ = &Cursor::seek__<Varchar>;
             insert_ = &Cursor::insert__<Varchar>;
             erase_ = &Cursor::erase__<Varchar>;
+            load_ = &Cursor::load__<Varchar>;
             break;
     }
 }
@@ -39,6 +49,7 @@ void Cursor::open(const Field& origin) {
     origin_ = origin;
     eot_ = false;
     leaf_node_ = nullptr;
+    reset_read_ahead();
 }
 
 /* Advance to the next slot.
@@ -52,10 +63,12 @@ bool Cursor::next() {
 }
 
 /* Return the current slot as a RowView.
- * Validates the Cursor before reading from the current slot. */
+ * Validates the Cursor before reading from the current slot.
+ * If the Cursor is writable then the slot is marked as modified. */
 RowView Cursor::current() {
     validate();
     if (eot_) throw EndOfTreeException("current");
+    if (writable_) return RowView{leaf_node_->mutable_slot(slot_), schema_};
     return RowView{leaf_node_->slot(slot_), schema_};
 }
 
@@ -66,10 +79,67 @@ RowView Cursor::current() {
 void Cursor::validate() {
     if (slot_ != leaf_node_->size()) return;
     if (!leaf_node_->is_rightmost()) {
-        leaf_node_ = bp_tree_->open_leaf(leaf_node_->next_leaf());
+        read_ahead();
+        if (bulk_ && !ring_) use_ring();
+        leaf_node_ = bp_tree_->open_leaf(leaf_node_->next_leaf(), ring_.get());
         slot_ = 0;
     }
     else eot_ = true;
 }
 
-} // namespace minisql
\ No newline at end of file
+/* Prefetch the leaves after the next leaf before stepping onto it, once the
+ * Cursor has stepped along the leaf chain READ_AHEAD_THRESHOLD_ times since it
+ * was opened.
+ * A window of the following leaves (from the parent of leaf_node_) is
+ * prefetched, and the next window only once the Cursor reaches the trigger leaf
+ * halfway through it. The window doubles each time up to MAX_READ_AHEAD_ or an
+ * eighth of the cache so that a scan cannot evict the working set, but is
+ * halved if prefetched pages have been evicted without being used.
+ * Does nothing unless the FrameManager reads pages asynchronously. */
+void Cursor::read_ahead() {
+    const page_id_t next = leaf_node_->next_leaf();
+    if (++chain_steps_ < READ_AHEAD_THRESHOLD_) return;
+    if (read_ahead_trigger_ != nullpid && next != read_ahead_trigger_) return;
+
+    FrameManager* fm = bp_tree_->frame_manager();
+    if (!fm->async_io()) return;
+    const std::size_t cap = std::min(MAX_READ_AHEAD_, fm->cache_capacity() / 8);
+    const std::uint64_t misses = fm->prefetch_stats().misses;
+    if (misses > read_ahead_misses_)
+        read_ahead_window_ = std::max<std::size_t>(read_ahead_window_ / 2, 1);
+    else if (!read_ahead_window_) read_ahead_window_ = MIN_READ_AHEAD_;
+    else read_ahead_window_ *= 2;
+    read_ahead_window_ = std::min(read_ahead_window_, cap);
+    read_ahead_misses_ = misses;
+    if (!read_ahead_window_) return;
+
+    std::vector<page_id_t> pids = bp_tree_->sibling_leaves(
+        leaf_node_.get(), read_ahead_window_ + 1
+    );
+    if (!pids.empty() && pids.front() == next) pids.erase(pids.begin());
+    fm->prefetch(pids, ring_.get());
+    read_ahead_trigger_ = pids.empty() ? nullpid : pids[pids.size() / 2];
+}
+
+// Forget any sequential access seen, as the Cursor has been repositioned.
+void Cursor::reset_read_ahead() {
+    chain_steps_ = 0;
+    read_ahead_window_ = 0;
+    read_ahead_trigger_ = nullpid;
+}
+
+/* Start reading leaves through a ScanRing once the Cursor has stepped along
+ * the leaf chain more times than a quarter of the cache holds, so that a bulk
+ * scan of a small table still leaves it cached but that of a large one only
+ * recycles the Frames of the ring. The ring holds a quarter of the cache,
+ * between MIN_RING_ and MAX_RING_ Frames, which leaves room for the leaves
+ * read ahead to wait in it until they are stepped onto. */
+void Cursor::use_ring() {
+    const std::size_t capacity = bp_tree_->frame_manager()->cache_capacity();
+    if (chain_steps_ <= capacity / 4) return;
+    ring_ = std::make_unique<ScanRing>(
+        std::clamp(capacity / 4, MIN_RING_, MAX_RING_)
+    );
+}
+
+} // namespace minisql
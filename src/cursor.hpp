@@ -1,47 +1,90 @@
 #ifndef MINISQL_CURSOR_HPP
 #define MINISQL_CURSOR_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 #include "bplus_tree/bplus_tree.hpp"
 #include "bplus_tree/leaf_node.hpp"
 #include "bplus_tree/node.hpp"
 #include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/cache/scan_ring.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
 #include "minisql/field.hpp"
 #include "row/row_view.hpp"
 #include "row/schema.hpp"
+#include "span.hpp"
 
 namespace minisql {
 
 /* Cursor
  * An interface for traversing and reading Rows from the LeafNodes of a B+
- * Tree. */
+ * Tree.
+ * Rows returned by a writable Cursor may be modified in-place.
+ * Once the Cursor is seen to be walking along the leaf chain it reads the
+ * following leaves ahead asynchronously (see read_ahead).
+ * A Cursor marked as making a bulk scan reads leaves through a ScanRing of its
+ * own once the scan proves large (see use_ring). */
 class Cursor {
 public:
-    Cursor(BPlusTree* bp_tree, const Schema& schema);
+    Cursor(BPlusTree* bp_tree, const Schema& schema, bool writable = false);
 
     void open(const Field& origin = 0);
-    void seek(const Field& key) { (this->*seek_)(key); }
+    void seek(const Field& key) {
+        reset_read_ahead();
+        (this->*seek_)(key);
+    }
     bool next();
     RowView current();
     void insert(const RowView& rv) { (this->*insert_)(rv); }
     void erase() { (this->*erase_)(); }
 
+    /* Build bp_tree_ bottom-up from the given Rows (see BPlusTree::bulk_load),
+     * returning false if it is not empty or the Rows share a key. */
+    bool load(std::vector<span<std::byte>> rows, double fill_factor) {
+        return (this->*load_)(std::move(rows), fill_factor);
+    }
+
+    // Mark the Cursor as scanning the whole of bp_tree_.
+    void set_bulk() noexcept { bulk_ = true; }
+
 private:
     BPlusTree* bp_tree_;
     std::shared_ptr<Schema> schema_;
+    bool writable_;
     Field origin_ {0};
     bool eot_ {true};
     std::unique_ptr<LeafNode> leaf_node_ {nullptr};
     Node::size_t slot_;
 
+    std::size_t chain_steps_ {0};
+    std::size_t read_ahead_window_ {0};
+    page_id_t read_ahead_trigger_ {nullpid};
+    std::uint64_t read_ahead_misses_ {0};
+
+    static constexpr std::size_t READ_AHEAD_THRESHOLD_ = 2;
+    static constexpr std::size_t MIN_READ_AHEAD_ = 4;
+    static constexpr std::size_t MAX_READ_AHEAD_ = 64;
+
+    bool bulk_ {false};
+    std::unique_ptr<ScanRing> ring_ {nullptr};
+
+    static constexpr std::size_t MIN_RING_ = 4;
+    static constexpr std::size_t MAX_RING_ = 2 * MAX_READ_AHEAD_;
+
     void (Cursor::* seek_)(const Field&);
     void (Cursor::* insert_)(const RowView&);
     void (Cursor::* erase_)();
+    bool (Cursor::* load_)(std::vector<span<std::byte>>, double);
 
     void validate();
+    void read_ahead();
+    void reset_read_ahead();
+    void use_ring();
 
     template <typename Key>
     void seek__(const Field& key) {
@@ -85,6 +128,12 @@ private:
         bp_tree_->erase_from<Key>(leaf_node_.get(), slot_);
         eot_ = true;
     }
+
+    template <typename Key>
+    bool load__(std::vector<span<std::byte>> rows, double fill_factor) {
+        leaf_node_ = nullptr;
+        return bp_tree_->bulk_load<Key>(std::move(rows), fill_factor);
+    }
 };
 
 } // namespace minisql
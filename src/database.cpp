@@ -1,7 +1,10 @@
 #include "database.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <ios>
 #include <memory>
 #include <string>
@@ -12,109 +15,387 @@
 #include "bplus_tree/bplus_tree.hpp"
 #include "byte_io.hpp"
 #include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/cache/buffer_pool.hpp"
+#include "frame_manager/disk_manager/file.hpp"
+#include "frame_manager/disk_manager/memory_file.hpp"
 #include "frame_manager/disk_manager/page_id_t.hpp"
 #include "frame_manager/frame_manager.hpp"
+#include "frame_manager/warm_list/warm_list.hpp"
 #include "headers.hpp"
+#include "minisql/options.hpp"
 #include "row/schema.hpp"
 
 namespace minisql {
 
-// Create or read the Database header and initialise fm_ and catalog_.
-Database::Database(const std::filesystem::path& path) {
-    page_id_t page_count {0}, first_free_list_block {nullpid};
-    if (!std::filesystem::exists(path)) {
-        file_.open(path, std::ios::out);
-        if (!file_) throw std::ios_base::failure(
-            "Failed to open database: " + path.string()
+namespace {
+
+/* Return whether the file at path starts with the magic number of a
+ * LegacyDatabaseHeader. */
+bool is_legacy(const std::filesystem::path& path) {
+    std::ifstream file{path, std::ios::binary};
+    char magic;
+    return file.get(magic) &&
+        static_cast<Magic>(magic) == Magic::LEGACY_DATABASE;
+}
+
+} // namespace
+
+/* Create or read the Database header and initialise fm_ and catalog_.
+ * A file written before the format was versioned is first rewritten in the
+ * current format (see migrate), and a FormatException is thrown if the file
+ * has any other format version.
+ * An in-memory database has no header: its pages are held in a MemoryFile and
+ * the cache is given room to hold every one of them. */
+Database::Database(
+    const std::filesystem::path& path, const Options& options,
+    FileBackend backend, std::weak_ptr<BufferPool>* shared_pool
+) : in_memory_{options.in_memory || path == MEMORY_PATH},
+    reclaim_pages_{options.reclaim_pages},
+    fill_factor_{options.fill_factor} {
+    if (in_memory_) {
+        page_size_ = options.page_size;
+        validate_page_size();
+        master_root_ = nullpid;
+        file_ = std::make_unique<MemoryFile>(options.memory_limit);
+        const std::size_t max_pages = options.memory_limit / page_size_;
+        fm_ = std::make_unique<FrameManager>(
+            *file_, 0, page_size_, 0, max_pages, nullpid, false, false,
+            options.extent_pages, false, max_pages, options.cache_policy,
+            options.huge_pages
+        );
+        reclaimer_ = std::make_unique<Reclaimer>(fm_.get());
+        return;
+    }
+
+    page_id_t page_count {0}, first_free_map_block {nullpid};
+    page_id_t first_warm_list_block {nullpid};
+    page_id_t first_reclaim_list_block {nullpid};
+    const bool exists = std::filesystem::exists(path);
+    if (exists && is_legacy(path)) migrate(path);
+    if (!exists) {
+        page_size_ = options.page_size;
+        validate_page_size(options.direct_io);
+    }
+    file_ = open_file(path, backend, options.direct_io);
+
+    /* Pages start after the space reserved for the header, unless the file
+     * was created for direct I/O in which case they start at page_size_ so
+     * that every page is aligned. The offset is recorded in the header. */
+    if (!exists) {
+        base_offset_ = file_->direct() ?
+            page_size_ : DatabaseHeader::RESERVED_SIZE;
+        const std::vector<std::byte> reserved(
+            DatabaseHeader::RESERVED_SIZE, std::byte{0xff}
         );
-        file_.close();
-        file_.open(path, std::ios::in | std::ios::out | std::ios::binary);
+        file_->resize(base_offset_);
+        file_->write(0, reserved.data(), reserved.size());
         master_root_ = nullpid;
-        flush_header(page_count, first_free_list_block);
+        flush_header(
+            page_count, first_free_map_block, first_warm_list_block,
+            first_reclaim_list_block
+        );
     }
     else {
-        file_.open(path, std::ios::in | std::ios::out | std::ios::binary);
-        if (!file_) throw std::ios_base::failure(
-            "Failed to open database: " + path.string()
-        );
         std::vector<std::byte> db_header{DatabaseHeader::SIZE};
-        file_.seekg(0);
-        file_.read(
-            reinterpret_cast<char*>(db_header.data()), DatabaseHeader::SIZE
-        );
+        file_->read(0, db_header.data(), DatabaseHeader::SIZE);
         Magic magic = byte_io::view<Magic>(
             db_header, DatabaseHeader::MAGIC_OFFSET
         );
         if (magic != Magic::DATABASE) throw MagicException(magic);
+        const auto version = byte_io::view<DatabaseHeader::format_version_t>(
+            db_header, DatabaseHeader::FORMAT_VERSION_OFFSET
+        );
+        if (version != DatabaseHeader::FORMAT_VERSION)
+            throw FormatException(
+                "format version " + std::to_string(version) + " (expected " +
+                std::to_string(DatabaseHeader::FORMAT_VERSION) + ")"
+            );
         page_count = byte_io::view<page_id_t>(
             db_header, DatabaseHeader::PAGE_COUNT_OFFSET
         );
-        first_free_list_block = byte_io::view<page_id_t>(
-            db_header, DatabaseHeader::FIRST_FREE_LIST_BLOCK_OFFSET
+        first_free_map_block = byte_io::view<page_id_t>(
+            db_header, DatabaseHeader::FIRST_FREE_MAP_BLOCK_OFFSET
         );
         master_root_ = byte_io::view<page_id_t>(
             db_header, DatabaseHeader::MASTER_ROOT_OFFSET
         );
+        page_size_ = byte_io::view<DatabaseHeader::page_size_t>(
+            db_header, DatabaseHeader::PAGE_SIZE_OFFSET
+        );
+        base_offset_ = byte_io::view<DatabaseHeader::base_offset_t>(
+            db_header, DatabaseHeader::BASE_OFFSET_OFFSET
+        );
+        first_warm_list_block = byte_io::view<page_id_t>(
+            db_header, DatabaseHeader::FIRST_WARM_LIST_BLOCK_OFFSET
+        );
+        first_reclaim_list_block = byte_io::view<page_id_t>(
+            db_header, DatabaseHeader::FIRST_RECLAIM_LIST_BLOCK_OFFSET
+        );
+        validate_page_size(options.direct_io);
     }
     fm_ = std::make_unique<FrameManager>(
-        file_, DatabaseHeader::SIZE, PAGE_SIZE_, page_count, CACHE_CAPACITY_,
-        first_free_list_block
+        *file_, base_offset_, page_size_, page_count,
+        initial_cache_capacity(options), first_free_map_block, options.mmap,
+        options.async_io, options.extent_pages, options.compress,
+        options.max_cache_capacity, options.cache_policy, options.huge_pages,
+        options.background_writer ? options.dirty_ratio : 0,
+        join_pool(shared_pool, options)
     );
+
+    /* The warm list is only kept until the next open, so its pages are freed
+     * even if they are not to be read back in. */
+    warm_up_ = options.warm_up;
+    if (first_warm_list_block != nullpid) {
+        std::vector<page_id_t> pids =
+            warm_list::load(*fm_, first_warm_list_block);
+        if (warm_up_)
+            warm_up_stats_ = warm_list::warm_up(*fm_, std::move(pids));
+    }
+
+    // Carry on reclaiming the pages of Tables erased in an earlier session
+    reclaimer_ = std::make_unique<Reclaimer>(fm_.get());
+    if (first_reclaim_list_block != nullpid)
+        reclaimer_->load(first_reclaim_list_block);
 }
 
-// Flush any dirty pages and update the DatabaseHeader.
+/* Flush any dirty pages and update the DatabaseHeader, first recording the
+ * pages still to be reclaimed and the pages in the cache if warming up.
+ * The pages of an in-memory database are discarded instead. */
 Database::~Database() {
+    if (in_memory_) {
+        fm_->discard();
+        return;
+    }
+    std::vector<page_id_t> stale = reclaimer_->take_blocks();
+    const page_id_t first_reclaim_list_block = reclaimer_->save();
+    page_id_t first_warm_list_block = nullpid;
+    if (warm_up_)
+        first_warm_list_block = warm_list::save(*fm_, fm_->hot_pages());
+    fm_->deallocate(stale);
     fm_->flush_all();
-    flush_header(fm_->page_count(), fm_->first_free_list_block());
+    flush_header(
+        fm_->page_count(), fm_->first_free_map_block(), first_warm_list_block,
+        first_reclaim_list_block
+    );
 }
 
-// Construct a Table in the Catalog with given name.
+/* Construct a Table in the Catalog with given name.
+ * The pages of a Table with CachePriority::KEEP are kept in the cache. */
 void Database::add_table(
     const std::string& name, std::unique_ptr<Schema> schema, page_id_t root,
-    rowid_t next_rowid
+    rowid_t next_rowid, CachePriority cache_priority
 ) {
     auto bp_tree = std::make_unique<BPlusTree>(
-        fm_.get(), schema->primary().size, schema->row_size(), root
+        fm_.get(), schema->primary().size, schema->row_size(), root,
+        cache_priority == CachePriority::KEEP
     );
     tables_.emplace(
         std::piecewise_construct,
         std::forward_as_tuple(name),
-        std::forward_as_tuple(std::move(bp_tree), std::move(schema), next_rowid)
+        std::forward_as_tuple(
+            std::move(bp_tree), std::move(schema), next_rowid, cache_priority
+        )
     );
 }
 
-/* Remove the Table with given name from the Catalog.
+/* Remove the Table with given name from the Catalog, leaving its pages to be
+ * freed by reclaimer_.
  * Does nothing if the Table does not exist. */
 void Database::erase_table(const std::string& name) {
     auto it = tables_.find(name);
     if (it == tables_.end()) return;
-    it->second.bp_tree->destroy();
+    reclaimer_->add(*it->second.bp_tree);
     tables_.erase(it);
 }
 
-// Write the database header to the start of file_.
-void Database::flush_header(
-    page_id_t page_count, page_id_t first_free_list_block
-) {
+/* Free up to budget pages of erased Tables (at least one, if any are left)
+ * and return how many were freed. Unless the database is in memory, the pages
+ * left are first recorded by a checkpoint, so that the pages freed here are
+ * not freed again after a crash. */
+std::size_t Database::reclaim(std::size_t budget) {
+    if (in_memory_) return reclaimer_->step(budget);
+    std::vector<page_id_t> pids = reclaimer_->take_pages(budget);
+    if (pids.empty()) return 0;
+    checkpoint();
+    fm_->deallocate(pids);
+    return pids.size();
+}
+
+/* Record the pages still to be reclaimed in a new chain, then flush every
+ * dirty page and the DatabaseHeader, so that erased Tables are reclaimed even
+ * if the database is not closed. The pages of the chain this replaces are
+ * only freed afterwards, so a crash may leave pages unused but never frees
+ * one twice.
+ * Does nothing for an in-memory database. */
+void Database::checkpoint() {
+    if (in_memory_) return;
+    std::vector<page_id_t> stale = reclaimer_->take_blocks();
+    const page_id_t first_reclaim_list_block = reclaimer_->save();
+    fm_->flush_all();
+    flush_header(
+        fm_->page_count(), fm_->first_free_map_block(), nullpid,
+        first_reclaim_list_block
+    );
+    fm_->deallocate(stale);
+}
+
+/* Return the number of pages the cache should start with: as many as fit in
+ * options.cache_size (at least one) if it is set, otherwise
+ * options.cache_capacity. */
+std::size_t Database::initial_cache_capacity(const Options& options) const {
+    if (!options.cache_size) return options.cache_capacity;
+    return std::max<std::size_t>(options.cache_size / page_size_, 1);
+}
+
+/* Return the BufferPool shared_pool refers to if options.shared_cache is set,
+ * first setting one up for this database from options if it has expired.
+ * Returns nullptr (for the database to have a pool of its own) if there is no
+ * shared pool to use or it has a different page size. */
+std::shared_ptr<BufferPool> Database::join_pool(
+    std::weak_ptr<BufferPool>* shared_pool, const Options& options
+) const {
+    if (!shared_pool || !options.shared_cache) return nullptr;
+    std::shared_ptr<BufferPool> pool = shared_pool->lock();
+    if (!pool) {
+        pool = std::make_shared<BufferPool>(
+            page_size_, initial_cache_capacity(options),
+            options.max_cache_capacity, options.cache_policy,
+            options.huge_pages,
+            options.background_writer ? options.dirty_ratio : 0
+        );
+        *shared_pool = pool;
+    }
+    return pool->page_size() == page_size_ ? pool : nullptr;
+}
+
+// Return the bytes of the database header.
+std::vector<std::byte> Database::header(
+    page_id_t page_count, page_id_t first_free_map_block,
+    page_id_t first_warm_list_block, page_id_t first_reclaim_list_block
+) const {
     std::vector<std::byte> db_header{DatabaseHeader::SIZE};
     byte_io::write<Magic>(
         db_header, DatabaseHeader::MAGIC_OFFSET, Magic::DATABASE
     );
+    byte_io::write<DatabaseHeader::format_version_t>(
+        db_header, DatabaseHeader::FORMAT_VERSION_OFFSET,
+        DatabaseHeader::FORMAT_VERSION
+    );
     byte_io::write<page_id_t>(
         db_header, DatabaseHeader::PAGE_COUNT_OFFSET, page_count
     );
     byte_io::write<page_id_t>(
-        db_header, DatabaseHeader::FIRST_FREE_LIST_BLOCK_OFFSET,
-        first_free_list_block
+        db_header, DatabaseHeader::FIRST_FREE_MAP_BLOCK_OFFSET,
+        first_free_map_block
     );
     byte_io::write<page_id_t>(
         db_header, DatabaseHeader::MASTER_ROOT_OFFSET, master_root_
     );
-    file_.seekp(0);
-    file_.write(
-        reinterpret_cast<const char*>(db_header.data()), DatabaseHeader::SIZE
+    byte_io::write<DatabaseHeader::page_size_t>(
+        db_header, DatabaseHeader::PAGE_SIZE_OFFSET,
+        static_cast<DatabaseHeader::page_size_t>(page_size_)
     );
-    file_.flush();
+    byte_io::write<DatabaseHeader::base_offset_t>(
+        db_header, DatabaseHeader::BASE_OFFSET_OFFSET,
+        static_cast<DatabaseHeader::base_offset_t>(base_offset_)
+    );
+    byte_io::write<page_id_t>(
+        db_header, DatabaseHeader::FIRST_WARM_LIST_BLOCK_OFFSET,
+        first_warm_list_block
+    );
+    byte_io::write<page_id_t>(
+        db_header, DatabaseHeader::FIRST_RECLAIM_LIST_BLOCK_OFFSET,
+        first_reclaim_list_block
+    );
+    return db_header;
+}
+
+// Write the database header to the start of file_.
+void Database::flush_header(
+    page_id_t page_count, page_id_t first_free_map_block,
+    page_id_t first_warm_list_block, page_id_t first_reclaim_list_block
+) {
+    const std::vector<std::byte> db_header = header(
+        page_count, first_free_map_block, first_warm_list_block,
+        first_reclaim_list_block
+    );
+    file_->write(0, db_header.data(), db_header.size());
+    file_->flush();
+}
+
+/* Rewrite the file at path, which starts with a LegacyDatabaseHeader, in the
+ * current format. Its pages are copied into a new file after the space
+ * reserved for a DatabaseHeader, which then replaces it, so that the file is
+ * left as it was if this fails part way. The FreeList it may hold is emptied
+ * into a FreeMap once the file is opened.
+ * Throws a FormatException if the size of the file does not match its
+ * header, and a FileIOException if the new file cannot be written. */
+void Database::migrate(const std::filesystem::path& path) {
+    std::ifstream in{path, std::ios::binary};
+    std::vector<std::byte> legacy_header{LegacyDatabaseHeader::SIZE};
+    in.read(
+        reinterpret_cast<char*>(legacy_header.data()),
+        LegacyDatabaseHeader::SIZE
+    );
+    if (!in) throw FormatException("truncated header");
+    const page_id_t page_count = byte_io::view<page_id_t>(
+        legacy_header, LegacyDatabaseHeader::PAGE_COUNT_OFFSET
+    );
+    const std::uintmax_t size = std::filesystem::file_size(path);
+    if (size != LegacyDatabaseHeader::SIZE +
+        std::uintmax_t{page_count} * LegacyDatabaseHeader::PAGE_SIZE)
+        throw FormatException(
+            "unversioned file of " + std::to_string(size) +
+            " bytes does not match the original format"
+        );
+    page_size_ = LegacyDatabaseHeader::PAGE_SIZE;
+    base_offset_ = DatabaseHeader::RESERVED_SIZE;
+    master_root_ = byte_io::view<page_id_t>(
+        legacy_header, LegacyDatabaseHeader::MASTER_ROOT_OFFSET
+    );
+
+    std::filesystem::path temp_path = path;
+    temp_path += ".migrate";
+    {
+        std::ofstream out{temp_path, std::ios::binary | std::ios::trunc};
+        std::vector<std::byte> db_header = header(
+            page_count, byte_io::view<page_id_t>(
+                legacy_header,
+                LegacyDatabaseHeader::FIRST_FREE_LIST_BLOCK_OFFSET
+            ), nullpid, nullpid
+        );
+        db_header.resize(base_offset_, std::byte{0xff});
+        out.write(
+            reinterpret_cast<const char*>(db_header.data()), db_header.size()
+        );
+        std::vector<char> page(page_size_);
+        for (page_id_t pid = 0; pid < page_count && in && out; pid++) {
+            in.read(page.data(), page.size());
+            out.write(page.data(), page.size());
+        }
+        if (!in || !out.flush()) {
+            out.close();
+            std::filesystem::remove(temp_path);
+            throw FileIOException(
+                "migrate", LegacyDatabaseHeader::SIZE,
+                "copying pages to " + temp_path.string() + " failed"
+            );
+        }
+    }
+    std::filesystem::rename(temp_path, path);
+}
+
+/* Throw a PageSizeException if page_size_ is not a power of two within the
+ * range supported by DatabaseHeader, or if direct_io is set and page_size_ is
+ * below DIRECT_IO_ALIGNMENT: every write of a smaller page would have to read
+ * and write back the whole block it lies in. */
+void Database::validate_page_size(bool direct_io) const {
+    if (page_size_ < DatabaseHeader::MIN_PAGE_SIZE ||
+        page_size_ > DatabaseHeader::MAX_PAGE_SIZE ||
+        page_size_ & (page_size_ - 1))
+        throw PageSizeException(page_size_);
+    if (direct_io && page_size_ < DIRECT_IO_ALIGNMENT)
+        throw PageSizeException(page_size_, DIRECT_IO_ALIGNMENT);
 }
 
 } // namespace minisql
\ No newline at end of file
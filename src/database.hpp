@@ -3,23 +3,53 @@
 
 #include <cstddef>
 #include <filesystem>
-#include <fstream>
+#include <ios>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "bplus_tree/reclaimer.hpp"
+#include "catalog/cache_priority.hpp"
 #include "catalog/catalog.hpp"
+#include "frame_manager/cache/buffer_pool.hpp"
+#include "frame_manager/disk_manager/file.hpp"
 #include "frame_manager/disk_manager/page_id_t.hpp"
 #include "frame_manager/frame_manager.hpp"
+#include "headers.hpp"
+#include "minisql/cache_stats.hpp"
+#include "minisql/options.hpp"
 #include "row/schema.hpp"
 
 namespace minisql {
 
 /* Database
- * Opens a FrameManager on the file with given path, and manages a catalog of
- * Tables within that file. */
+ * Opens a FrameManager on the file with given path (accessed through the given
+ * FileBackend and configured by options), and manages a catalog of Tables
+ * within that file.
+ * The page size is chosen from options when the file is created and read from
+ * its DatabaseHeader thereafter.
+ * A file written before the format was versioned is rewritten in the current
+ * format when opened.
+ * If options.in_memory is set or path is MEMORY_PATH then no file is used and
+ * the database only lasts as long as the Database.
+ * The capacity of the cache can be changed while open, in pages or bytes, up
+ * to the larger of options.max_cache_capacity and the initial capacity.
+ * If shared_pool is given and options.shared_cache is set then pages are held
+ * in the BufferPool it refers to (setting one up if it has expired), provided
+ * that pool has the same page size.
+ * If options.warm_up is set then the pages in the cache when the database is
+ * closed are recorded in the file, and read back in when it is next opened.
+ * The pages of erased Tables are left to a Reclaimer, whose pending pages are
+ * recorded in the file when the database is closed. */
 class Database : public Catalog {
 public:
-    Database(const std::filesystem::path& path);
+    static constexpr const char* MEMORY_PATH = ":memory:";
+
+    Database(
+        const std::filesystem::path& path, const Options& options = {},
+        FileBackend backend = FileBackend::POSITIONAL,
+        std::weak_ptr<BufferPool>* shared_pool = nullptr
+    );
     ~Database();
 
     page_id_t master_root() const { return master_root_; }
@@ -27,21 +57,62 @@ public:
 
     void add_table(
         const std::string& name, std::unique_ptr<Schema> schema,
-        page_id_t root = nullpid, rowid_t next_rowid = 0
+        page_id_t root = nullpid, rowid_t next_rowid = 0,
+        CachePriority cache_priority = CachePriority::NORMAL
     ) override;
 
     void erase_table(const std::string& name) override;
+    std::size_t reclaim(std::size_t budget) override;
+    std::size_t reclaim_pages() const noexcept { return reclaim_pages_; }
+    void checkpoint();
+
+    std::size_t page_size() const override { return page_size_; }
+    double fill_factor() const override { return fill_factor_; }
+
+    std::size_t cache_capacity() const noexcept {
+        return fm_->cache_capacity();
+    }
+    std::size_t set_cache_capacity(std::size_t pages) {
+        return fm_->resize_cache(pages);
+    }
+    std::size_t set_cache_size(std::size_t bytes) {
+        return fm_->resize_cache(bytes / page_size_);
+    }
+    const CacheStats& cache_stats() const noexcept {
+        return fm_->cache_stats();
+    }
+    const WarmUpStats& warm_up_stats() const noexcept {
+        return warm_up_stats_;
+    }
+    bool in_memory() const noexcept { return in_memory_; }
 
 private:
-    std::fstream file_;
+    const bool in_memory_;
+    std::unique_ptr<File> file_;
     page_id_t master_root_;
+    std::size_t page_size_;
+    std::streamoff base_offset_ {DatabaseHeader::RESERVED_SIZE};
     std::unique_ptr<FrameManager> fm_;
+    bool warm_up_ {false};
+    WarmUpStats warm_up_stats_;
+    std::unique_ptr<Reclaimer> reclaimer_;
+    std::size_t reclaim_pages_;
+    double fill_factor_;
 
-    void flush_header(page_id_t page_count, page_id_t first_free_list_block);
-
-    // FrameManager arguments.
-    static constexpr std::size_t PAGE_SIZE_ = 4096;
-    static constexpr std::size_t CACHE_CAPACITY_ = 2000;
+    std::size_t initial_cache_capacity(const Options& options) const;
+    std::shared_ptr<BufferPool> join_pool(
+        std::weak_ptr<BufferPool>* shared_pool, const Options& options
+    ) const;
+    std::vector<std::byte> header(
+        page_id_t page_count, page_id_t first_free_map_block,
+        page_id_t first_warm_list_block, page_id_t first_reclaim_list_block
+    ) const;
+    void flush_header(
+        page_id_t page_count, page_id_t first_free_map_block,
+        page_id_t first_warm_list_block, page_id_t first_reclaim_list_block
+    );
+    void migrate(const std::filesystem::path& path);
+    void validate_page_size(bool direct_io = false) const;
 };
 
 } // namespace minisql
@@ -4,13 +4,20 @@
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <sstream>
 #include <string_view>
 #include <utility>
 #include <variant>
+#include <vector>
 
+#include "catalog/cache_priority.hpp"
 #include "database.hpp"
 #include "engine/database_handle.hpp"
 #include "engine/master_table.hpp"
+#include "field/type.hpp"
+#include "frame_manager/disk_manager/file.hpp"
+#include "minisql/field.hpp"
+#include "minisql/options.hpp"
 #include "minisql/row.hpp"
 #include "minisql/row_set.hpp"
 #include "minisql/varchar.hpp"
@@ -19,21 +26,54 @@
 #include "planner/planner.hpp"
 #include "row/schema.hpp"
 #include "row_set/row_set_impl.hpp"
+#include "validator/constants.hpp"
 #include "validator/query.hpp"
 #include "validator/validator.hpp"
 
 namespace minisql {
 
+namespace {
+
+/* Return sql declaring the columns of the Table created by query, and its
+ * cache priority if not the default, to record in the master table in place
+ * of a CREATE TABLE ... AS statement. */
+std::string build_create_statement(const validator::CreateQuery& query) {
+    std::ostringstream sql;
+    sql << "CREATE TABLE " << query.table << " (";
+    for (std::size_t i = 0; i < query.columns.size(); i++) {
+        if (query.columns[i] == validator::defaults::primary::NAME) continue;
+        if (i) sql << ", ";
+        sql << query.columns[i];
+        switch (query.types[i]) {
+            case FieldType::INT: sql << " INT"; break;
+            case FieldType::REAL: sql << " REAL"; break;
+            case FieldType::TEXT: sql << " TEXT(" << query.sizes[i] << ")";
+        }
+    }
+    sql << ")";
+    if (query.cache_priority == CachePriority::KEEP)
+        sql << " WITH (cache = keep)";
+    sql << ";";
+    return sql.str();
+}
+
+} // namespace
+
 /* Return a DatabaseHandle providing access to the database with given path.
  * If the database is already open then a new DatabaseHandle is created and
- * returned.
- * Otherwise the database is opened and stored, the master table and its
- * contents is added to the database's catalog and then a new DatabaseHandle
- * is created and returned. */
-DatabaseHandle Engine::open_database(const std::filesystem::path& path) {
+ * returned (options are ignored).
+ * Otherwise the database is opened with options and stored, the master table
+ * and its contents is added to the database's catalog and then a new
+ * DatabaseHandle is created and returned. The master table, read on every open
+ * and close, is kept in the cache. */
+DatabaseHandle Engine::open_database(
+    const std::filesystem::path& path, const Options& options
+) {
     auto it = dbs_.find(path);
     if (it != dbs_.end()) return DatabaseHandle{*this, it->second, path};
-    auto db = std::make_shared<Database>(path);
+    auto db = std::make_shared<Database>(
+        path, options, FileBackend::POSITIONAL, &shared_pool_
+    );
     auto create_ast = std::get<parser::CreateAST>(
         parser::parse(master_table::build_create_statement())
     );
@@ -43,7 +83,7 @@ DatabaseHandle Engine::open_database(const std::filesystem::path& path) {
             create_ast.columns, create_ast.types, create_ast.sizes,
             *(create_ast.primary)
         ),
-        db->master_root()
+        db->master_root(), 0, CachePriority::KEEP
     );
     RowSet tables = query(master_table::build_select_statement(), *db);
     for (Row& table_info : tables) {
@@ -61,7 +101,8 @@ DatabaseHandle Engine::open_database(const std::filesystem::path& path) {
                 c_query.columns, c_query.types, c_query.sizes, c_query.primary
             ),
             std::get<int>(table_info[master_table::columns::ROOT.name]),
-            std::get<int>(table_info[master_table::columns::NEXT_ROWID.name])
+            std::get<int>(table_info[master_table::columns::NEXT_ROWID.name]),
+            c_query.cache_priority
         );
     }
     dbs_[path] = db;
@@ -75,17 +116,24 @@ void Engine::release_database(const std::filesystem::path& path) {
     if (it == dbs_.end()) return;
     auto db = it->second;
     if (db.use_count() > 2) return;
+    record_tables(*db);
+    dbs_.erase(it);
+}
+
+/* Record the root and next rowid of every table of the given database in its
+ * master table, and the root of the master table as its master_root. */
+void Engine::record_tables(Database& db) {
     RowSet tables = query(
         master_table::build_select_statement(
             {master_table::columns::TABLE_NAME}
         ),
-        *db
+        db
     );
     for (Row& table_info : tables) {
         const std::string& table_name = std::get<Varchar>(
             table_info[master_table::columns::TABLE_NAME.name]
         ).data();
-        const Table* table = db->find_table(table_name);
+        const Table* table = db.find_table(table_name);
         exec(
             master_table::build_update_statement(
                 {
@@ -98,38 +146,73 @@ void Engine::release_database(const std::filesystem::path& path) {
                         std::to_string(table->next_rowid)
                     }
                 }, table_name
-            ), *db, true
+            ), db, true
         );
     }
-    db->set_master_root(db->find_table(master_table::NAME)->bp_tree->root());
-    dbs_.erase(it);
+    db.set_master_root(db.find_table(master_table::NAME)->bp_tree->root());
 }
 
-// Execute the given sql on the given database.
+/* Execute the given sql on the given database, first freeing some pages of
+ * any dropped tables. Dropping a table is followed by a checkpoint of the
+ * database (see Database::checkpoint) once it is removed from the master
+ * table, so that its pages are reclaimed even if the database is not
+ * closed. */
 std::size_t Engine::exec(
     std::string_view sql, Database& db, bool master_enabled
 ) {
+    if (!master_enabled && db.reclaim_pages()) db.reclaim(db.reclaim_pages());
     parser::AST ast = parser::parse(sql);
     validator::Query query = validator::validate(ast, db, master_enabled);
+    // The values of an InsertQuery are moved into its plan
+    if (auto* i_query = std::get_if<validator::InsertQuery>(&query)) {
+        planner::Plan plan =
+            planner::plan(validator::Query{std::move(*i_query)}, db);
+        while (plan->next());
+        return plan->count();
+    }
     planner::Plan plan = planner::plan(query, db);
     while (plan->next());
     if (std::holds_alternative<validator::CreateQuery>(query)) {
-        std::string table_name = std::get<validator::CreateQuery>(query).table;
-        const Table* table = db.find_table(table_name);
+        const auto& c_query = std::get<validator::CreateQuery>(query);
+        const Table* table = db.find_table(c_query.table);
         exec(
             master_table::build_insert_statement(
-                table_name, sql.data(), table->bp_tree->root(),
-                table->next_rowid
+                c_query.table,
+                c_query.select ? build_create_statement(c_query) : sql.data(),
+                table->bp_tree->root(), table->next_rowid
             ), db, true
         );
+        // Kept current for the checkpoints made while reclaiming pages
+        db.set_master_root(
+            db.find_table(master_table::NAME)->bp_tree->root()
+        );
     }
     else if (std::holds_alternative<validator::DropQuery>(query)) {
         std::string table_name = std::get<validator::DropQuery>(query).table;
         exec(master_table::build_delete_statement(table_name), db, true);
+        record_tables(db);
+        db.checkpoint();
     }
     return plan->count();
 }
 
+/* Insert the given rows of Fields into the table with given name on the given
+ * database, first freeing some pages of any dropped tables. The rows are
+ * inserted as by an INSERT of every column, so that many rows are loaded into
+ * an empty table in bulk. */
+std::size_t Engine::import(
+    const std::string& table, std::vector<std::vector<Field>> rows,
+    Database& db
+) {
+    if (db.reclaim_pages()) db.reclaim(db.reclaim_pages());
+    validator::InsertQuery query =
+        validator::validate(table, std::move(rows), db);
+    planner::Plan plan =
+        planner::plan(validator::Query{std::move(query)}, db);
+    while (plan->next());
+    return plan->count();
+}
+
 /* Return a RowSet containing all rows output when executing the given sql on
  * the given database. */
 RowSet Engine::query(std::string_view sql, Database& db) {
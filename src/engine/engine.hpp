@@ -7,9 +7,13 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "database.hpp"
 #include "engine/database_handle.hpp"
+#include "frame_manager/cache/buffer_pool.hpp"
+#include "minisql/field.hpp"
+#include "minisql/options.hpp"
 #include "minisql/row_set.hpp"
 
 namespace minisql {
@@ -36,21 +40,32 @@ struct PathEqual {
 };
 
 /* Engine
- * Manages access to Databases and handles execution of sql on them. */
+ * Manages access to Databases and handles execution of sql on them.
+ * Databases opened with Options::shared_cache hold their pages in one
+ * BufferPool, kept for as long as any of them is open. */
 class Engine {
 public:
-    DatabaseHandle open_database(const std::filesystem::path& path);
+    DatabaseHandle open_database(
+        const std::filesystem::path& path, const Options& options = {}
+    );
     void release_database(const std::filesystem::path& path);
 
     std::size_t exec(
         std::string_view sql, Database& db, bool master_enabled = false
     );
     RowSet query(std::string_view sql, Database& db);
+    std::size_t import(
+        const std::string& table, std::vector<std::vector<Field>> rows,
+        Database& db
+    );
 
 private:
+    void record_tables(Database& db);
+
     std::unordered_map<
         std::filesystem::path, std::shared_ptr<Database>, PathHash, PathEqual
     > dbs_;
+    std::weak_ptr<BufferPool> shared_pool_;
 };
 
 } // namespace minisql
@@ -41,6 +41,55 @@ public:
         ) {}
 };
 
+// Thrown when an in-memory database would outgrow its memory limit.
+class MemoryLimitException : public EngineException {
+public:
+    explicit MemoryLimitException(std::size_t limit)
+        : EngineException(
+            "in-memory database exceeds its memory limit of " +
+            std::to_string(limit) + " bytes"
+        ) {}
+};
+
+// Thrown when a database page size is not a supported power of two, or is
+// too small for direct I/O.
+class PageSizeException : public EngineException {
+public:
+    explicit PageSizeException(std::size_t page_size)
+        : EngineException(
+            "unsupported page size " + std::to_string(page_size) +
+            " (must be a power of two from " +
+            std::to_string(DatabaseHeader::MIN_PAGE_SIZE) + " to " +
+            std::to_string(DatabaseHeader::MAX_PAGE_SIZE) + " bytes)"
+        ) {}
+
+    PageSizeException(std::size_t page_size, std::size_t alignment)
+        : EngineException(
+            "page size " + std::to_string(page_size) +
+            " is below the direct I/O alignment of " +
+            std::to_string(alignment) + " bytes"
+        ) {}
+};
+
+// Thrown when a transfer to or from the on-disk file fails.
+class FileIOException : public EngineException {
+public:
+    FileIOException(
+        const std::string& action, std::size_t offset,
+        const std::string& reason
+    ) : EngineException(
+        "unable to " + action + " file at offset " + std::to_string(offset) +
+        " - " + reason
+    ) {}
+};
+
+// Thrown when a compressed page cannot be decompressed.
+class CompressionException : public EngineException {
+public:
+    explicit CompressionException(const std::string& reason)
+        : EngineException("unable to decompress page - " + reason) {}
+};
+
 /* Base class for exceptions occurring when pinning pages to or unpinning pages
  * from frames. */
 class CacheException : public EngineException {
@@ -65,6 +114,14 @@ public:
         "all pages in the cache are pinned - cannot evict") {}
 };
 
+/* Thrown when a database file is in a format that cannot be read, such as one
+ * with a later format version. */
+class FormatException : public EngineException {
+public:
+    explicit FormatException(const std::string& reason)
+        : EngineException("unsupported database file format - " + reason) {}
+};
+
 // Thrown when a file or page header has an unexpected magic number.
 class MagicException : public EngineException {
 public:
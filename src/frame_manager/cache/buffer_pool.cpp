@@ -0,0 +1,366 @@
+#include "frame_manager/cache/buffer_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/cache/cache.hpp"
+#include "frame_manager/cache/frame.hpp"
+#include "frame_manager/cache/replacer.hpp"
+#include "frame_manager/cache/slab.hpp"
+#include "frame_manager/disk_manager/disk_manager.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "minisql/options.hpp"
+#include "span.hpp"
+
+namespace minisql {
+
+/* Constructor for BufferPool.
+ * Allocates a Slab for the buffers of up to max_capacity Frames (raised to at
+ * least capacity) and reserves room for the Frames themselves. Starts the
+ * background writer if dirty_ratio is nonzero. */
+BufferPool::BufferPool(
+    std::size_t page_size, std::size_t capacity, std::size_t max_capacity,
+    CachePolicy policy, bool huge_pages, double dirty_ratio
+) : page_size_{page_size}, capacity_{capacity},
+    max_capacity_{std::max(capacity, max_capacity)},
+    slab_{max_capacity_ * page_size_, huge_pages},
+    replacer_{make_replacer(policy, 0)}, dirty_ratio_{dirty_ratio} {
+    frames_.reserve(max_capacity_);
+    if (dirty_ratio_ > 0)
+        writer_ = std::thread{&BufferPool::write_behind, this};
+}
+
+// Stop the background writer, if running.
+BufferPool::~BufferPool() {
+    if (!writer_.joinable()) return;
+    {
+        std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+    writer_cv_.notify_one();
+    writer_.join();
+}
+
+/* Return a lock on the pool, which must be held while using it if the
+ * background writer is running. Otherwise the pool is only used by one thread
+ * and the returned lock holds nothing. */
+std::unique_lock<std::mutex> BufferPool::lock() {
+    if (!writer_.joinable()) return {};
+    return std::unique_lock{mutex_};
+}
+
+/* Register cache as an owner of pages in the pool and return its owner id.
+ * Throws a CacheException if the pool already has as many owners as the ids
+ * can tell apart. */
+BufferPool::owner_t BufferPool::attach(Cache* cache) {
+    auto guard = lock();
+    auto it = std::find(owners_.begin(), owners_.end(), nullptr);
+    if (it != owners_.end()) {
+        *it = cache;
+        return static_cast<owner_t>(it - owners_.begin());
+    }
+    if (owners_.size() > std::numeric_limits<owner_t>::max())
+        throw CacheException("too many caches share the buffer pool");
+    owners_.push_back(cache);
+    return static_cast<owner_t>(owners_.size() - 1);
+}
+
+/* Drop every page of the given owner, without writing any back, and free its
+ * owner id for reuse. The owner must have flushed its pages and have none
+ * pinned. */
+void BufferPool::detach(owner_t owner) {
+    auto guard = lock();
+    wait_for_writer();
+    for (std::size_t fid = 0; fid < frames_.size(); fid++) {
+        Frame& f = frames_[fid];
+        if (f.owner != owner || f.pid == nullpid) continue;
+        replacer_->remove(fid);
+        set_dirty(f, false);
+        f.loading = false;
+        f.prefetched = false;
+        release(fid);
+    }
+    owners_[owner] = nullptr;
+}
+
+/* Record that the Frame at fid has been (pinned and) loaded with the page at
+ * pid belonging to owner. */
+void BufferPool::admit(std::size_t fid, owner_t owner, page_id_t pid) {
+    frames_[fid].owner = owner;
+    replacer_->admit(fid, static_cast<std::uint64_t>(owner) << 32 | pid);
+}
+
+/* Return the index of a free Frame for owner.
+ * If the pool is below capacity_ then a Frame holding no page is used (setting
+ * up a new one if needed), otherwise the page in the Frame chosen by replacer_
+ * is evicted by its owner. The page is flushed to the disk first if
+ * write_back is set or it belongs to another owner. If every Frame is pinned
+ * then one beyond capacity_ is used instead, and only once max_capacity_
+ * Frames are pinned is a CacheCapacityException thrown. */
+std::size_t BufferPool::get_free_fid(owner_t owner, bool write_back) {
+
+    if (size() > capacity_) trim();
+    if (size() < capacity_) return take_free_fid();
+
+    std::size_t fid = evict();
+    if (fid != Replacer::npos) {
+        Frame& f = frames_[fid];
+        owners_[f.owner]->evict(f, write_back || f.owner != owner);
+        return fid;
+    }
+    fid = take_free_fid();
+    if (fid == NO_FRAME) throw CacheCapacityException();
+    return fid;
+}
+
+/* Set whether the page in the given Frame is kept in the pool. A page is only
+ * marked to be kept while it is pinned and fewer than keep_limit() Frames are.
+ * Once unmarked it is evictable whenever it is unpinned. */
+void BufferPool::keep(Frame& f, bool keep) {
+    if (f.keep == keep) return;
+    if (keep) {
+        if (!f.pin_count || kept_ >= keep_limit()) return;
+        f.keep = true;
+        kept_++;
+        return;
+    }
+    f.keep = false;
+    kept_--;
+    if (!f.pin_count) replacer_->unpin(fid(&f));
+}
+
+/* Take the unpinned Frame at fid out of replacer_ so that its owner can read
+ * another page into it directly, waiting for any write back of its page by the
+ * background writer first. */
+void BufferPool::reclaim(std::size_t fid) {
+    if (frames_[fid].writing) wait_for_writer();
+    replacer_->remove(fid);
+}
+
+/* Give up the unpinned page in the Frame at fid without writing it back, for
+ * when the page has been freed, and return the Frame to the free Frames. */
+void BufferPool::drop(std::size_t fid) {
+    Frame& f = frames_[fid];
+    keep(f, false);
+    reclaim(fid);
+    set_dirty(f, false);
+    owners_[f.owner]->evict(f, false);
+    release(fid);
+}
+
+/* Set the capacity of the pool, clamped to between 1 and max_capacity_, and
+ * return it.
+ * Growing only raises the limit, with Frames set up as they are needed.
+ * Shrinking evicts unpinned pages (writing back any that are dirty) until
+ * the pool is within its new capacity. If too many pages are pinned for that
+ * then the rest are evicted as they are unpinned and more Frames are needed,
+ * so that shrinking never causes a CacheCapacityException. */
+std::size_t BufferPool::resize(std::size_t capacity) {
+    auto guard = lock();
+    capacity_ = std::clamp<std::size_t>(capacity, 1, max_capacity_);
+    trim();
+    return capacity_;
+}
+
+/* Return the page_id_t's of the pages of owner, those most worth keeping
+ * first: any that are pinned or kept, then the rest in the order replacer_
+ * would keep them. */
+std::vector<page_id_t> BufferPool::hot_pages(owner_t owner) {
+    auto guard = lock();
+    std::vector<page_id_t> pids;
+    for (const Frame& f : frames_) {
+        if (f.owner == owner && f.pid != nullpid && (f.pin_count || f.keep))
+            pids.push_back(f.pid);
+    }
+    for (std::size_t fid : replacer_->ranked()) {
+        const Frame& f = frames_[fid];
+        if (f.owner == owner && f.pid != nullpid) pids.push_back(f.pid);
+    }
+    return pids;
+}
+
+/* Return the index of a Frame holding no page, setting up a new Frame with its
+ * buffer sliced from slab_ if there are none. Returns NO_FRAME if all
+ * max_capacity_ Frames hold pages.
+ * Existing Frames (and FrameViews of them) are not moved by setting up a new
+ * one as frames_ has already reserved room for max_capacity_ Frames. */
+std::size_t BufferPool::take_free_fid() {
+    if (!free_fids_.empty()) {
+        const std::size_t fid = free_fids_.back();
+        free_fids_.pop_back();
+        return fid;
+    }
+    if (frames_.size() == max_capacity_) return NO_FRAME;
+    const std::size_t fid = frames_.size();
+    Frame& f = frames_.emplace_back();
+    f.data.assign(slab_.data() + fid * page_size_, page_size_);
+    replacer_->resize(frames_.size());
+    return fid;
+}
+
+/* Choose an evictable Frame with replacer_ and return its index, or
+ * Replacer::npos if there is none. If a copy of its page is still being
+ * written back by the background writer then the write is waited for first,
+ * so that the page cannot be read back from the disk before it lands. */
+std::size_t BufferPool::evict() {
+    const std::size_t fid = replacer_->evict();
+    if (fid != Replacer::npos && frames_[fid].writing) wait_for_writer();
+    return fid;
+}
+
+/* Evict unpinned pages while the pool is above capacity_, releasing their
+ * Frames' buffers back to the system. */
+void BufferPool::trim() {
+    while (size() > capacity_) {
+        const std::size_t fid = evict();
+        if (fid == Replacer::npos) return;
+        Frame& f = frames_[fid];
+        owners_[f.owner]->evict(f, true);
+        release(fid);
+    }
+}
+
+// Return the Frame at fid, whose page has been dropped, to the free Frames.
+void BufferPool::release(std::size_t fid) {
+    Frame& f = frames_[fid];
+    if (f.keep) {
+        f.keep = false;
+        kept_--;
+    }
+    f.pid = nullpid;
+    f.mapped = nullptr;
+    slab_.release(f.data.data(), f.data.size());
+    free_fids_.push_back(static_cast<frame_id_t>(fid));
+}
+
+/* Set whether the given Frame is dirty, keeping count of dirty Frames and
+ * waking the background writer once there are too many. */
+void BufferPool::set_dirty(Frame& f, bool dirty) {
+    if (f.dirty == dirty) return;
+    f.dirty = dirty;
+    if (!dirty) {
+        dirty_--;
+        return;
+    }
+    if (++dirty_ > dirty_limit() && writer_.joinable()) writer_cv_.notify_one();
+}
+
+/* Wait for any batch of pages being written back by the background writer.
+ * The pool must be locked. */
+void BufferPool::wait_for_writer() {
+    if (writing_) idle_cv_.wait(mutex_, [this] { return !writing_; });
+}
+
+// Return the number of dirty Frames.
+std::size_t BufferPool::dirty() {
+    auto guard = lock();
+    return dirty_;
+}
+
+/* Body of the background writer thread.
+ * Sleeps until more than dirty_ratio_ of the capacity is dirty, then writes
+ * dirty unpinned pages back, in order of owner and page_id_t, until at most
+ * half that is. Pages are written in batches of up to WRITER_BATCH_ from the
+ * same owner. If no page could be written (as every dirty page is pinned)
+ * then the writer waits for up to WRITER_BACKOFF_ before looking again.
+ * The writer stops if a write fails, leaving the pages dirty so that the
+ * failure is met by the owning thread when it writes them back itself. */
+void BufferPool::write_behind() {
+    struct Candidate {
+        owner_t owner;
+        page_id_t pid;
+        frame_id_t fid;
+    };
+    Slab copies{WRITER_BATCH_ * page_size_};
+    std::vector<Candidate> candidates;
+    std::vector<PageBuffer> pages;
+    std::vector<frame_id_t> fids;
+
+    std::unique_lock lock{mutex_};
+    while (true) {
+        writer_cv_.wait(lock, [this] {
+            return stopping_ || dirty_ > dirty_limit();
+        });
+        if (stopping_) return;
+
+        candidates.clear();
+        for (std::size_t fid = 0; fid < frames_.size(); fid++) {
+            const Frame& f = frames_[fid];
+            if (f.dirty && !f.pin_count && !f.loading) {
+                candidates.push_back(
+                    {f.owner, f.pid, static_cast<frame_id_t>(fid)}
+                );
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) {
+                return a.owner != b.owner ? a.owner < b.owner : a.pid < b.pid;
+            }
+        );
+
+        bool written = false;
+        for (std::size_t i = 0; i < candidates.size() && !stopping_ &&
+            dirty_ > dirty_limit() / 2;) {
+            const owner_t owner = candidates[i].owner;
+            pages.clear();
+            fids.clear();
+            for (; i < candidates.size() && pages.size() < WRITER_BATCH_ &&
+                candidates[i].owner == owner; i++) {
+                const Candidate& c = candidates[i];
+                Frame& f = frames_[c.fid];
+                if (f.owner != c.owner || f.pid != c.pid || !f.dirty ||
+                    f.pin_count || f.loading) continue;
+                std::byte* copy = copies.data() + pages.size() * page_size_;
+                std::memcpy(copy, f.data.data(), page_size_);
+                pages.push_back({c.pid, copy});
+                fids.push_back(c.fid);
+            }
+            if (pages.empty()) continue;
+            if (!write_batch(pages, fids, owner, lock)) return;
+            written = true;
+        }
+        if (!written && !stopping_) writer_cv_.wait_for(lock, WRITER_BACKOFF_);
+    }
+}
+
+/* Write the given copies of the pages in the Frames at fids back to the disk
+ * of owner, with the pool unlocked meanwhile. The Frames are marked clean
+ * beforehand, and are marked writing so that they are not evicted until the
+ * write completes. Returns false (marking the Frames dirty again) if the
+ * write failed. */
+bool BufferPool::write_batch(
+    span<PageBuffer> pages, span<frame_id_t> fids, owner_t owner,
+    std::unique_lock<std::mutex>& lock
+) {
+    for (frame_id_t fid : fids) {
+        set_dirty(frames_[fid], false);
+        frames_[fid].writing = true;
+    }
+    DiskManager& disk = owners_[owner]->disk_;
+    writing_ = true;
+    lock.unlock();
+    bool written = true;
+    try {
+        disk.write(pages);
+    }
+    catch (...) {
+        written = false;
+    }
+    lock.lock();
+    for (frame_id_t fid : fids) {
+        frames_[fid].writing = false;
+        if (!written) set_dirty(frames_[fid], true);
+    }
+    writing_ = false;
+    idle_cv_.notify_all();
+    return written;
+}
+
+} // namespace minisql
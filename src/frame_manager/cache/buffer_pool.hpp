@@ -0,0 +1,156 @@
+#ifndef MINISQL_BUFFER_POOL_HPP
+#define MINISQL_BUFFER_POOL_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "frame_manager/cache/frame.hpp"
+#include "frame_manager/cache/replacer.hpp"
+#include "frame_manager/cache/slab.hpp"
+#include "frame_manager/disk_manager/disk_manager.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "minisql/options.hpp"
+#include "span.hpp"
+
+namespace minisql {
+
+class Cache;
+
+/* Buffer Pool
+ * Holds the Frames of one or more Caches, each caching the pages of its own
+ * DiskManager, within a single capacity so that memory goes to whichever of
+ * them needs it. Each Frame records its owner (the Cache its page belongs to)
+ * and victims are chosen across every Cache by one Replacer for the given
+ * CachePolicy, their owners then giving up the pages.
+ * Every Frame's buffer is a slice of one Slab aligned for direct I/O (and
+ * optionally backed by huge pages), while the Frames themselves are packed
+ * into a separate array.
+ * Frames are only set up as they are first needed. The capacity can be changed
+ * at any time up to max_capacity, for which room is reserved up front so that
+ * growing never moves existing Frames or their buffers. Shrinking evicts
+ * unpinned pages and releases their buffers. Capacity is a target rather than
+ * a hard limit: if every Frame is pinned then more are used (up to
+ * max_capacity) and handed back once unpinned.
+ * Pages can be marked to be kept, in which case they are never evicted while
+ * they stay marked, for as long as kept pages take up no more than
+ * a quarter of the capacity; pages marked beyond that are cached as usual.
+ * If dirty_ratio is nonzero then a background writer thread writes dirty
+ * unpinned pages back in page order whenever more than that fraction of the
+ * capacity is dirty, so that evictions rarely have to write. The pool is then
+ * guarded by a mutex, which its users take through lock(); otherwise lock()
+ * does nothing. */
+class BufferPool {
+public:
+    using frame_id_t = std::uint32_t;
+    using owner_t = std::uint16_t;
+    static constexpr frame_id_t NO_FRAME = static_cast<frame_id_t>(-1);
+
+    BufferPool(
+        std::size_t page_size, std::size_t capacity,
+        std::size_t max_capacity = 0, CachePolicy policy = CachePolicy::CLOCK,
+        bool huge_pages = false, double dirty_ratio = 0
+    );
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    std::unique_lock<std::mutex> lock();
+
+    owner_t attach(Cache* cache);
+    void detach(owner_t owner);
+
+    Frame& frame(std::size_t fid) noexcept { return frames_[fid]; }
+    std::size_t fid(const Frame* f) const noexcept {
+        return f - frames_.data();
+    }
+    std::size_t frame_count() const noexcept { return frames_.size(); }
+
+    void admit(std::size_t fid, owner_t owner, page_id_t pid);
+    void pin(std::size_t fid) { replacer_->pin(fid); }
+    void unpin(std::size_t fid) {
+        if (!frames_[fid].keep) replacer_->unpin(fid);
+    }
+    void keep(Frame& f, bool keep);
+    void reclaim(std::size_t fid);
+    void drop(std::size_t fid);
+    void set_dirty(Frame& f, bool dirty);
+    void wait_for_writer();
+
+    std::size_t get_free_fid(owner_t owner, bool write_back = true);
+
+    // Return true if no Frame is free or evictable within capacity.
+    bool full() const noexcept {
+        return size() >= capacity_ && !replacer_->size();
+    }
+
+    std::size_t resize(std::size_t capacity);
+
+    std::vector<page_id_t> hot_pages(owner_t owner);
+
+    std::size_t page_size() const noexcept { return page_size_; }
+    std::size_t capacity() const noexcept { return capacity_; }
+    std::size_t max_capacity() const noexcept { return max_capacity_; }
+    bool huge_pages() const noexcept { return slab_.huge_pages(); }
+    bool background_writer() const noexcept { return writer_.joinable(); }
+
+    // Return the number of Frames holding pages marked to be kept.
+    std::size_t kept() const noexcept { return kept_; }
+    std::size_t dirty();
+
+    // Return the number of Frames holding a page.
+    std::size_t size() const noexcept {
+        return frames_.size() - free_fids_.size();
+    }
+
+private:
+    // Largest number of pages the background writer writes back at once.
+    static constexpr std::size_t WRITER_BATCH_ = 32;
+
+    // How long the background writer waits if no dirty page was unpinned.
+    static constexpr std::chrono::milliseconds WRITER_BACKOFF_ {10};
+
+    std::size_t take_free_fid();
+    std::size_t evict();
+    void trim();
+    void release(std::size_t fid);
+
+    std::size_t keep_limit() const noexcept { return capacity_ / 4; }
+    std::size_t dirty_limit() const noexcept {
+        return static_cast<std::size_t>(capacity_ * dirty_ratio_);
+    }
+    void write_behind();
+    bool write_batch(
+        span<PageBuffer> pages, span<frame_id_t> fids, owner_t owner,
+        std::unique_lock<std::mutex>& lock
+    );
+
+    const std::size_t page_size_;
+    std::size_t capacity_;
+    const std::size_t max_capacity_;
+    Slab slab_;
+    std::vector<Frame> frames_;
+    std::vector<frame_id_t> free_fids_;
+    std::unique_ptr<Replacer> replacer_;
+    std::vector<Cache*> owners_;
+    std::size_t kept_ {0};
+    const double dirty_ratio_;
+    std::size_t dirty_ {0};
+
+    std::mutex mutex_;
+    std::condition_variable writer_cv_;
+    std::condition_variable_any idle_cv_;
+    bool writing_ {false};
+    bool stopping_ {false};
+    std::thread writer_;
+};
+
+} // namespace minisql
+
+#endif // MINISQL_BUFFER_POOL_HPP
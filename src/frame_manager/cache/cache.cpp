@@ -1,81 +1,321 @@
 #include "frame_manager/cache/cache.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/cache/buffer_pool.hpp"
 #include "frame_manager/cache/frame.hpp"
 #include "frame_manager/cache/frame_view.hpp"
+#include "frame_manager/cache/scan_ring.hpp"
+#include "frame_manager/disk_manager/disk_manager.hpp"
 #include "frame_manager/disk_manager/page_id_t.hpp"
+#include "minisql/options.hpp"
+#include "span.hpp"
 
 namespace minisql {
 
+/* Constructor for Cache.
+ * Caches the pages of disk in a BufferPool of its own with the given capacity,
+ * max_capacity, policy and huge_pages. */
+Cache::Cache(
+    DiskManager& disk, std::size_t capacity, std::size_t max_capacity,
+    CachePolicy policy, bool huge_pages
+) : Cache{disk, std::make_shared<BufferPool>(
+        disk.page_size(), capacity, max_capacity, policy, huge_pages
+    )} {}
+
+/* Constructor for Cache.
+ * Caches the pages of disk in the given BufferPool, which must have the same
+ * page size, else a CacheException is thrown. */
+Cache::Cache(DiskManager& disk, std::shared_ptr<BufferPool> pool)
+    : disk_{disk}, pool_{std::move(pool)} {
+    if (pool_->page_size() != disk_.page_size())
+        throw CacheException("page size does not match the buffer pool");
+    owner_ = pool_->attach(this);
+}
+
+// Flush any dirty pages and give up every Frame in the BufferPool.
+Cache::~Cache() {
+    flush_all();
+    pool_->detach(owner_);
+}
+
 /* Pin the page at pid into a Frame and return a FrameView containing a pointer
  * to it.
  * If the page is already pinned into a Frame then the pin_count in that Frame
- * is incremented instead. */
-FrameView Cache::pin(page_id_t pid) {
-
-    auto it = map_.find(pid);
-    if (it != map_.end()) {
-        Frame& f = frames_[it->second];
-        if (!f.pin_count) {
-            lru_.erase(f.lru_it);
-            f.lru_it = lru_.end();
+ * is incremented instead.
+ * If disk_ is mapped then the Frame points into the mapping rather than
+ * copying the page.
+ * If ring is given then a missed page is read into a Frame of the ring (see
+ * ring_fid). A page pinned without one is no longer the ring's to reuse. */
+FrameView Cache::pin(page_id_t pid, ScanRing* ring) {
+
+    auto lock = pool_->lock();
+    std::size_t fid = lookup(pid);
+    if (fid != NO_FRAME_) {
+        Frame& f = pool_->frame(fid);
+        if (f.loading) settle();
+        if (f.prefetched) {
+            f.prefetched = false;
+            prefetch_stats_.hits++;
         }
+        if (!ring) f.ring = false;
+        if (!f.pin_count) pool_->pin(fid);
         f.pin_count++;
+        stats_.hits++;
         return FrameView{this, &f};
     }
 
-    std::size_t fid = get_free_fid();
-    Frame& f = frames_[fid];
+    stats_.misses++;
+    fid = ring ? ring_fid(*ring, true) : pool_->get_free_fid(owner_);
+    Frame& f = pool_->frame(fid);
     f.pid = pid;
-    f.data.resize(disk_.page_size());
-    disk_.read(f.pid, f.data.data());
+    f.ring = ring != nullptr;
+    f.mapped = disk_.map(f.pid);
+    if (!f.mapped) disk_.read(f.pid, f.data.data());
     f.pin_count = 1;
-    map_[pid] = fid;
+    map(pid, fid);
+    pool_->admit(fid, owner_, pid);
+    return FrameView{this, &f};
+}
+
+/* Pin the page at pid, which has just been allocated so that its contents
+ * are not needed, into a zeroed Frame without reading it in. The Frame is
+ * marked dirty so that the page is written back even if left as zeros.
+ * As nothing is read this counts as neither a hit nor a miss. */
+FrameView Cache::pin_new(page_id_t pid) {
+
+    auto lock = pool_->lock();
+    std::size_t fid = lookup(pid);
+    if (fid != NO_FRAME_) {
+        Frame& f = pool_->frame(fid);
+        if (f.loading) settle();
+        f.prefetched = false;
+        f.ring = false;
+        if (!f.pin_count) pool_->pin(fid);
+        f.pin_count++;
+    }
+    else {
+        fid = pool_->get_free_fid(owner_);
+        Frame& f = pool_->frame(fid);
+        f.pid = pid;
+        f.ring = false;
+        f.pin_count = 1;
+        map(pid, fid);
+        pool_->admit(fid, owner_, pid);
+    }
+    Frame& f = pool_->frame(fid);
+    f.mapped = nullptr;
+    std::memset(f.data.data(), 0, f.data.size());
+    pool_->set_dirty(f, true);
     return FrameView{this, &f};
 }
 
 /* Unpin the page at pid from its Frame.
  * If the Frame has pin_count > 1 then the pin_count is decremented only. */
 void Cache::unpin(page_id_t pid, bool dirty) {
+    auto lock = pool_->lock();
+    const std::size_t fid = lookup(pid);
+    if (fid == NO_FRAME_) throw CacheUnpinException(pid, "not in cache");
+    release(pool_->frame(fid), dirty);
+}
+
+/* Unpin the given Frame, which must belong to this Cache.
+ * The index of the Frame follows from its address, so no lookup is needed. */
+void Cache::unpin_frame(Frame* f, bool dirty) {
+    auto lock = pool_->lock();
+    release(*f, dirty);
+}
+
+// Unpin the Frame f once, with the pool already locked.
+void Cache::release(Frame& f, bool dirty) {
+    if (!f.pin_count)
+        throw CacheUnpinException(f.pid, "pin_count already 0");
 
-    auto it = map_.find(pid);
-    if (it == map_.end()) throw CacheUnpinException(pid, "not in cache");
+    if (dirty) pool_->set_dirty(f, true);
+    if (!(--f.pin_count)) pool_->unpin(pool_->fid(&f));
+}
 
-    Frame& f = frames_[it->second];
-    if (!f.pin_count) throw CacheUnpinException(pid, "pin_count already 0");
+/* Read the pages at pids into unpinned Frames in a single batch.
+ * Pages already in the cache or beyond the end of disk_ are skipped, and
+ * prefetching stops early once no Frame outside of the batch is free. Any
+ * dirty Frames of this Cache evicted to make room are written back together
+ * before the reads are submitted. The Frames of the batch only become
+ * evictable once it has been assembled. If ring is given then the pages are
+ * read into Frames of the ring where possible.
+ * Does nothing if disk_ is mapped. */
+void Cache::prefetch(span<page_id_t> pids, ScanRing* ring) {
+
+    if (disk_.mapped()) return;
+    auto lock = pool_->lock();
+    settle();
+
+    std::vector<PageBuffer> writes, reads;
+    std::vector<frame_id_t> fids;
+    for (page_id_t pid : pids) {
+        if (pid >= disk_.page_count() || lookup(pid) != NO_FRAME_) continue;
+        if (pool_->full()) break;
+
+        std::size_t fid = ring ?
+            ring_fid(*ring, false) : pool_->get_free_fid(owner_, false);
+        Frame& f = pool_->frame(fid);
+        if (f.dirty) {
+            writes.push_back({f.pid, f.data.data()});
+            pool_->set_dirty(f, false);
+        }
+        f.pid = pid;
+        f.ring = ring != nullptr;
+        f.loading = true;
+        f.prefetched = true;
+        prefetch_stats_.pages++;
+        map(pid, fid);
+        pool_->admit(fid, owner_, pid);
+        fids.push_back(static_cast<frame_id_t>(fid));
+        reads.push_back({pid, f.data.data()});
+    }
+    for (std::size_t fid : fids) pool_->unpin(fid);
 
-    f.dirty |= dirty;
-    if (!(--f.pin_count)) {
-        lru_.push_front(it->second);
-        f.lru_it = lru_.begin();
+    if (!writes.empty()) {
+        disk_.write_async(writes);
+        disk_.wait();
     }
+    if (reads.empty()) return;
+    disk_.read_async(reads);
+    in_flight_ = std::move(fids);
 }
 
-/* Return the index of a free Frame.
- * If needed, evicts a Frame from lru_ and flushes the page contained within it
- * to the disk. */
-std::size_t Cache::get_free_fid() {
+/* Flush every dirty Frame of this Cache to the disk.
+ * The pages are written back in page_id_t order, coalescing adjacent pages
+ * into single writes. Returns the syscalls and bytes used. */
+WriteStats Cache::flush_all() {
+    auto lock = pool_->lock();
+    pool_->wait_for_writer();
+    settle();
+    std::vector<PageBuffer> writes;
+    for (std::size_t fid = 0; fid < pool_->frame_count(); fid++) {
+        Frame& f = pool_->frame(fid);
+        if (!f.dirty || f.owner != owner_) continue;
+        writes.push_back({f.pid, f.data.data()});
+        pool_->set_dirty(f, false);
+    }
+    return disk_.write(writes);
+}
+
+/* Mark every Frame of this Cache clean so that its contents are dropped instead
+ * of being flushed to the disk, for when the pages will never be read again. */
+void Cache::discard() {
+    auto lock = pool_->lock();
+    settle();
+    for (std::size_t fid = 0; fid < pool_->frame_count(); fid++) {
+        Frame& f = pool_->frame(fid);
+        if (f.owner == owner_) pool_->set_dirty(f, false);
+    }
+}
 
-    if (next_free_fid_ < capacity_) return next_free_fid_++;
+/* Mark the given Frame, which must belong to this Cache and be pinned, clean
+ * so that its contents are dropped instead of being flushed to the disk. */
+void Cache::clean_frame(Frame* f) {
+    auto lock = pool_->lock();
+    pool_->set_dirty(*f, false);
+}
 
-    if (lru_.empty()) throw CacheCapacityException();
+/* Mark the page in the given Frame, which must belong to this Cache and be
+ * pinned, to be kept in the pool. */
+void Cache::keep_frame(Frame* f) {
+    auto lock = pool_->lock();
+    pool_->keep(*f, true);
+}
+
+/* Stop keeping the page at pid in the pool, if it is held and was marked to
+ * be kept, for when it is freed. */
+void Cache::unkeep(page_id_t pid) {
+    auto lock = pool_->lock();
+    const std::size_t fid = lookup(pid);
+    if (fid != NO_FRAME_) pool_->keep(pool_->frame(fid), false);
+}
+
+/* Give up the pages at pids that are held without writing them back, for when
+ * they are freed. Any that are pinned are only no longer kept. */
+void Cache::drop(span<page_id_t> pids) {
+    auto lock = pool_->lock();
+    settle();
+    for (page_id_t pid : pids) {
+        const std::size_t fid = lookup(pid);
+        if (fid == NO_FRAME_) continue;
+        Frame& f = pool_->frame(fid);
+        if (f.pin_count) pool_->keep(f, false);
+        else pool_->drop(fid);
+    }
+}
 
-    std::size_t free_fid = lru_.back();
-    lru_.pop_back();
-    Frame& f = frames_[free_fid];
-    f.lru_it = lru_.end();
-    flush(f);
-    map_.erase(f.pid);
-    return free_fid;
+/* Give up the page in the given Frame, which the BufferPool has evicted,
+ * first flushing it to the disk if write_back is set. */
+void Cache::evict(Frame& f, bool write_back) {
+    if (f.loading) settle();
+    if (f.prefetched) {
+        f.prefetched = false;
+        prefetch_stats_.misses++;
+    }
+    if (write_back) flush(f);
+    table_[f.pid] = NO_FRAME_;
+    size_--;
 }
 
 // Flush the given Frame to the disk if it is dirty.
 void Cache::flush(Frame& f) {
     if (!f.dirty) return;
     disk_.write(f.pid, f.data.data());
-    f.dirty = false;
+    pool_->set_dirty(f, false);
+}
+
+/* Return the index of a free Frame for a page read through ring, advancing it
+ * to its next slot.
+ * The Frame in the slot is reused if it still holds a page of this Cache read
+ * through a ring that is not pinned, in flight or yet to be pinned since being
+ * prefetched, giving that page up (flushing it to the disk first if
+ * write_back is set). Otherwise a Frame is taken from the pool as usual and
+ * replaces it in the slot, the Frame it replaces being left to the pool's
+ * Replacer. */
+std::size_t Cache::ring_fid(ScanRing& ring, bool write_back) {
+    BufferPool::frame_id_t& slot = ring.fids_[ring.next_];
+    ring.next_ = (ring.next_ + 1) % ring.fids_.size();
+    if (slot != NO_FRAME_) {
+        Frame& f = pool_->frame(slot);
+        if (f.ring && !f.keep && f.owner == owner_ && f.pid != nullpid &&
+            lookup(f.pid) == slot && !f.pin_count && !f.loading &&
+            !f.prefetched) {
+            pool_->reclaim(slot);
+            evict(f, write_back);
+            return slot;
+        }
+    }
+    slot = static_cast<frame_id_t>(pool_->get_free_fid(owner_, write_back));
+    return slot;
+}
+
+/* Record that the page at pid is held in the Frame at fid, first growing
+ * table_ to cover every page of disk_ if needed. */
+void Cache::map(page_id_t pid, std::size_t fid) {
+    if (pid >= table_.size()) {
+        table_.resize(
+            std::max<std::size_t>(pid + 1, disk_.page_count()), NO_FRAME_
+        );
+    }
+    table_[pid] = static_cast<frame_id_t>(fid);
+    size_++;
+}
+
+// Wait for any prefetched pages still in flight.
+void Cache::settle() {
+    if (in_flight_.empty()) return;
+    disk_.wait();
+    for (frame_id_t fid : in_flight_) pool_->frame(fid).loading = false;
+    in_flight_.clear();
 }
 
 } // namespace minisql
\ No newline at end of file
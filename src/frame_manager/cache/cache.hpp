@@ -2,51 +2,123 @@
 #define MINISQL_CACHE_HPP
 
 #include <cstddef>
-#include <list>
-#include <unordered_map>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
+#include "frame_manager/cache/buffer_pool.hpp"
 #include "frame_manager/cache/frame.hpp"
 #include "frame_manager/disk_manager/disk_manager.hpp"
 #include "frame_manager/disk_manager/page_id_t.hpp"
+#include "minisql/cache_stats.hpp"
+#include "minisql/options.hpp"
+#include "span.hpp"
 
 namespace minisql {
 
 class FrameView;
+class ScanRing;
+
+/* Counters for prefetched pages.
+ * A hit is a prefetched page that was pinned before being evicted and a miss
+ * is one that was evicted without ever being pinned. */
+struct PrefetchStats {
+    std::uint64_t pages {0};
+    std::uint64_t hits {0};
+    std::uint64_t misses {0};
+};
 
 /* Cache
- * Holds Frames in memory. Maps page_id_t's to those Frames and manages LRU
- * eviction and dirty page flushing. */
+ * Caches the pages of a DiskManager in Frames of a BufferPool, either of its
+ * own (with the given capacity, max_capacity, CachePolicy and huge_pages) or
+ * shared with the Caches of other DiskManagers of the same page size. Maps
+ * page_id_t's to those Frames (through a page table indexed directly by
+ * page_id_t, as they are dense), gives up its pages when the pool evicts them
+ * and handles dirty page flushing.
+ * Pages can be prefetched in batches, in which case they are read through the
+ * asynchronous path of the DiskManager and only waited on once needed.
+ * Pages can be marked to be kept in the pool (see BufferPool), until they are
+ * unmarked when no longer needed.
+ * Pages pinned or prefetched through a ScanRing are read into the ring's own
+ * Frames where possible, so that bulk scans do not evict the working set.
+ * If the pool has a background writer then every operation holds the pool's
+ * lock, so that the writer only sees Frames between them. */
 class Cache {
 public:
-    Cache(DiskManager& disk, std::size_t capacity)
-        : disk_{disk}, capacity_{capacity}, frames_{capacity},
-        next_free_fid_{0} {
-        for (Frame& f : frames_) f.lru_it = lru_.end();
-    }
-    ~Cache() { flush_all(); }
+    Cache(
+        DiskManager& disk, std::size_t capacity, std::size_t max_capacity = 0,
+        CachePolicy policy = CachePolicy::CLOCK, bool huge_pages = false
+    );
+    Cache(DiskManager& disk, std::shared_ptr<BufferPool> pool);
+    ~Cache();
 
     Cache(const Cache&) = delete;
     Cache& operator=(const Cache&) = delete;
 
-    FrameView pin(page_id_t pid);
+    FrameView pin(page_id_t pid, ScanRing* ring = nullptr);
+    FrameView pin_new(page_id_t pid);
     void unpin(page_id_t pid, bool dirty);
+    void unpin_frame(Frame* f, bool dirty);
+
+    void prefetch(span<page_id_t> pids, ScanRing* ring = nullptr);
 
-    void flush_all() { for (Frame& f : frames_) flush(f); };
+    WriteStats flush_all();
+    void discard();
+    void clean_frame(Frame* f);
+    void keep_frame(Frame* f);
+    void unkeep(page_id_t pid);
+    void drop(span<page_id_t> pids);
 
-    std::size_t capacity() const noexcept { return capacity_; }
+    std::size_t resize(std::size_t capacity) {
+        return pool_->resize(capacity);
+    }
+
+    // Return the page_id_t's of the pages held, those most worth keeping first.
+    std::vector<page_id_t> hot_pages() const {
+        return pool_->hot_pages(owner_);
+    }
+
+    std::size_t capacity() const noexcept { return pool_->capacity(); }
+    std::size_t max_capacity() const noexcept {
+        return pool_->max_capacity();
+    }
+    bool huge_pages() const noexcept { return pool_->huge_pages(); }
+    const std::shared_ptr<BufferPool>& pool() const noexcept { return pool_; }
+
+    // Return the number of pages held.
+    std::size_t size() const noexcept { return size_; }
+
+    const CacheStats& stats() const noexcept { return stats_; }
+    const PrefetchStats& prefetch_stats() const noexcept {
+        return prefetch_stats_;
+    }
 
 private:
-    std::size_t get_free_fid();
+    friend class BufferPool;
+
+    using frame_id_t = BufferPool::frame_id_t;
+    static constexpr frame_id_t NO_FRAME_ = BufferPool::NO_FRAME;
+
+    // Return the index of the Frame holding the page at pid, or NO_FRAME_.
+    std::size_t lookup(page_id_t pid) const noexcept {
+        return pid < table_.size() ? table_[pid] : NO_FRAME_;
+    }
+    void map(page_id_t pid, std::size_t fid);
+    std::size_t ring_fid(ScanRing& ring, bool write_back);
 
+    void release(Frame& f, bool dirty);
+    void evict(Frame& f, bool write_back);
     void flush(Frame& f);
+    void settle();
 
     DiskManager& disk_;
-    const std::size_t capacity_;
-    std::vector<Frame> frames_;
-    std::unordered_map<page_id_t, std::size_t> map_;
-    std::list<std::size_t> lru_;
-    std::size_t next_free_fid_;
+    std::shared_ptr<BufferPool> pool_;
+    BufferPool::owner_t owner_;
+    std::vector<frame_id_t> table_;
+    std::size_t size_ {0};
+    std::vector<frame_id_t> in_flight_;
+    CacheStats stats_;
+    PrefetchStats prefetch_stats_;
 };
 
 } // namespace minisql
@@ -3,21 +3,70 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <list>
-#include <vector>
+#include <memory>
 
 #include "frame_manager/disk_manager/page_id_t.hpp"
+#include "span.hpp"
 
 namespace minisql {
 
-// In-memory object that can hold any page.
+/* Frame Buffer
+ * The memory holding the page of a Frame, either owned or borrowed from the
+ * Slab shared by all Frames in a Cache. */
+class FrameBuffer {
+public:
+    std::byte* data() noexcept { return data_; }
+    const std::byte* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    span<std::byte> bytes() noexcept { return {data_, size_}; }
+
+    // Own a zeroed buffer of size bytes.
+    void resize(std::size_t size) {
+        owned_ = std::make_unique<std::byte[]>(size);
+        data_ = owned_.get();
+        size_ = static_cast<std::uint32_t>(size);
+    }
+
+    // Borrow the size bytes starting from data.
+    void assign(std::byte* data, std::size_t size) noexcept {
+        owned_.reset();
+        data_ = data;
+        size_ = static_cast<std::uint32_t>(size);
+    }
+
+private:
+    std::unique_ptr<std::byte[]> owned_;
+    std::byte* data_ {nullptr};
+    std::uint32_t size_ {0};
+};
+
+/* In-memory object that can hold any page.
+ * If mapped is set then it points to the clean page within a read-only file
+ * mapping, and data only holds the page once it has been written to.
+ * If loading is set then an asynchronous read into data is still in flight.
+ * If prefetched is set then the page was read ahead and has not been pinned
+ * since.
+ * If writing is set then a copy of the page is being written back by a
+ * background writer.
+ * If ring is set then the page was read through a ScanRing and has only been
+ * pinned through one since, so the ring may reuse the Frame.
+ * If keep is set then the page is kept in the cache, so is not handed to the
+ * Replacer when unpinned.
+ * owner identifies the Cache the page belongs to within a BufferPool.
+ * Frames are kept in one array separate from the pages they hold, so members
+ * are ordered to pack each Frame into as few bytes as possible. */
 struct Frame {
+    FrameBuffer data;
+    std::byte* mapped {nullptr};
     page_id_t pid {nullpid};
-    std::vector<std::byte> data;
-    bool dirty {false};
     std::uint16_t pin_count {0};
-
-    std::list<std::size_t>::iterator lru_it {};
+    std::uint16_t owner {0};
+    bool dirty {false};
+    bool loading {false};
+    bool prefetched {false};
+    bool writing {false};
+    bool ring {false};
+    bool keep {false};
 };
 
 } // namespace minisql
@@ -6,7 +6,7 @@ namespace minisql {
 
 // Unpin the Frame.
 FrameView::~FrameView() {
-    if (cache_) cache_->unpin(f_->pid, dirty_);
+    if (cache_) cache_->unpin_frame(f_, dirty_);
 }
 
 // Move constructor needs to move all resources from other.
@@ -20,7 +20,7 @@ FrameView::FrameView(FrameView&& other)
 // Move assignment needs to unpin the current Frame and move all resources.
 FrameView& FrameView::operator=(FrameView&& other) {
     if (this != &other) {
-        if (cache_) cache_->unpin(f_->pid, dirty_);
+        if (cache_) cache_->unpin_frame(f_, dirty_);
         cache_ = other.cache_;
         other.cache_ = nullptr;
         f_ = other.f_;
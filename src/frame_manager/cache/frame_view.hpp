@@ -2,18 +2,21 @@
 #define MINISQL_FRAME_VIEW_HPP
 
 #include <cstddef>
+#include <cstring>
 
 #include "byte_io.hpp"
 #include "frame_manager/cache/cache.hpp"
 #include "frame_manager/cache/frame.hpp"
 #include "frame_manager/disk_manager/page_id_t.hpp"
+#include "span.hpp"
 
 namespace minisql {
 
 class Cache;
 
 /* Frame View
- * Small RAII object that provides access to a Frame. */
+ * Small RAII object that provides access to a Frame.
+ * Writing to a mapped Frame first copies the page out of the mapping. */
 class FrameView {
 public:
     FrameView(Cache* cache, Frame* f) : cache_{cache}, f_{f} {}
@@ -30,31 +33,50 @@ public:
 
     template <typename T>
     const T view(std::size_t offset, std::size_t size = sizeof(T)) const {
-        return byte_io::view<T>(f_->data, offset, size);
+        return byte_io::view<T>(bytes(), offset, size);
     }
 
     template <typename T>
     T copy(std::size_t offset, std::size_t size = sizeof(T)) const {
-        return byte_io::copy<T>(f_->data, offset, size);
+        return byte_io::copy<T>(bytes(), offset, size);
     }
 
     template <typename T>
     void write(std::size_t offset, const T& value) {
-        byte_io::write<T>(f_->data, offset, value);
+        byte_io::write<T>(
+            span<std::byte>{mutable_data(), f_->data.size()}, offset, value
+        );
+    }
+
+    // Return the page for reading only.
+    std::byte* data() const {
+        return f_->mapped ? f_->mapped : f_->data.data();
+    }
+
+    // Return the page for writing, marking it as dirty.
+    std::byte* mutable_data() {
+        if (f_->mapped) {
+            std::memcpy(f_->data.data(), f_->mapped, f_->data.size());
+            f_->mapped = nullptr;
+        }
         dirty_ = true;
+        return f_->data.data();
     }
-    
-    std::byte* data() const { return f_->data.data(); }
 
-    void mark_deleted() { 
-        f_->dirty = false;
+    void mark_deleted() {
+        cache_->clean_frame(f_);
         dirty_ = false;
     }
 
+    // Keep the page in the cache until it is freed.
+    void keep() { cache_->keep_frame(f_); }
+
 private:
     Cache* cache_;
     Frame* f_;
-    bool dirty_;
+    bool dirty_ {false};
+
+    span<std::byte> bytes() const { return {data(), f_->data.size()}; }
 };
 
 } // namespace minisql
@@ -0,0 +1,204 @@
+#include "frame_manager/cache/replacer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "minisql/options.hpp"
+#include "unreachable.hpp"
+
+namespace minisql {
+
+// Track Frames up to capacity, none of which are evictable yet.
+void LRUReplacer::resize(std::size_t capacity) {
+    its_.resize(capacity, lru_.end());
+}
+
+// Remove the Frame at fid from lru_ if it is there.
+void LRUReplacer::pin(std::size_t fid) {
+    if (its_[fid] == lru_.end()) return;
+    lru_.erase(its_[fid]);
+    its_[fid] = lru_.end();
+}
+
+// Move the Frame at fid to the front of lru_.
+void LRUReplacer::unpin(std::size_t fid) {
+    pin(fid);
+    lru_.push_front(fid);
+    its_[fid] = lru_.begin();
+}
+
+// Evict the Frame at the back of lru_.
+std::size_t LRUReplacer::evict() {
+    if (lru_.empty()) return npos;
+    const std::size_t fid = lru_.back();
+    lru_.pop_back();
+    its_[fid] = lru_.end();
+    return fid;
+}
+
+// Return the Frames in lru_, most recently unpinned first.
+std::vector<std::size_t> LRUReplacer::ranked() const {
+    return {lru_.begin(), lru_.end()};
+}
+
+// Track Frames up to capacity, none of which are evictable yet.
+void ClockReplacer::resize(std::size_t capacity) {
+    states_.resize(capacity, 0);
+}
+
+// Mark the Frame at fid as not evictable.
+void ClockReplacer::pin(std::size_t fid) {
+    if (states_[fid] & EVICTABLE) size_--;
+    states_[fid] = 0;
+}
+
+// Mark the Frame at fid as evictable and referenced.
+void ClockReplacer::unpin(std::size_t fid) {
+    if (!(states_[fid] & EVICTABLE)) size_++;
+    states_[fid] = EVICTABLE | REFERENCED;
+}
+
+/* Sweep hand_ round states_ until it reaches an evictable Frame that has not
+ * been referenced, clearing the reference of each evictable Frame passed.
+ * Takes at most two revolutions. */
+std::size_t ClockReplacer::evict() {
+    if (!size_) return npos;
+    while (true) {
+        const std::size_t fid = hand_;
+        if (++hand_ == states_.size()) hand_ = 0;
+        std::uint8_t& state = states_[fid];
+        if (!(state & EVICTABLE)) continue;
+        if (state & REFERENCED) {
+            state &= ~REFERENCED;
+            continue;
+        }
+        state = 0;
+        size_--;
+        return fid;
+    }
+}
+
+/* Return the evictable Frames referenced since the last sweep and then the
+ * rest, each in the order hand_ will next reach them from last to first. */
+std::vector<std::size_t> ClockReplacer::ranked() const {
+    std::vector<std::size_t> fids;
+    fids.reserve(size_);
+    for (bool referenced : {true, false}) {
+        const std::uint8_t state = referenced ? EVICTABLE | REFERENCED
+            : EVICTABLE;
+        for (std::size_t i = states_.size(); i > 0; i--) {
+            const std::size_t fid = (hand_ + i - 1) % states_.size();
+            if (states_[fid] == state) fids.push_back(fid);
+        }
+    }
+    return fids;
+}
+
+// Track Frames up to capacity, none of which are evictable yet.
+void TwoQueueReplacer::resize(std::size_t capacity) {
+    entries_.resize(capacity);
+}
+
+/* Admit page into the Frame at fid: into am_ if page was evicted from a1_
+ * recently, otherwise on probation into a1_. */
+void TwoQueueReplacer::admit(std::size_t fid, std::uint64_t page) {
+    Entry& entry = entries_[fid];
+    entry.page = page;
+    entry.resident = true;
+    auto ghost = ghosts_.find(page);
+    entry.hot = ghost != ghosts_.end();
+    if (entry.hot) {
+        a1_out_.erase(ghost->second);
+        ghosts_.erase(ghost);
+    }
+    else a1_resident_++;
+}
+
+// Remove the Frame at fid from its queue if it is there.
+void TwoQueueReplacer::pin(std::size_t fid) {
+    Entry& entry = entries_[fid];
+    if (!entry.queued) return;
+    queue(entry).erase(entry.it);
+    entry.queued = false;
+}
+
+/* Move the Frame at fid to the front of its queue. Frames never admitted
+ * (with no known page) join a1_. */
+void TwoQueueReplacer::unpin(std::size_t fid) {
+    pin(fid);
+    Entry& entry = entries_[fid];
+    if (!entry.resident) {
+        entry.resident = true;
+        entry.hot = false;
+        a1_resident_++;
+    }
+    std::list<std::size_t>& q = queue(entry);
+    q.push_front(fid);
+    entry.it = q.begin();
+    entry.queued = true;
+}
+
+/* Remove the Frame at fid from its queue, forgetting its page without
+ * remembering it as a ghost. */
+void TwoQueueReplacer::remove(std::size_t fid) {
+    pin(fid);
+    Entry& entry = entries_[fid];
+    if (entry.resident && !entry.hot) a1_resident_--;
+    entry.resident = false;
+    entry.page = NO_PAGE_;
+}
+
+/* Evict from the back of a1_ while it holds more than its share of Frames (or
+ * am_ has nothing evictable), otherwise from the back of am_. */
+std::size_t TwoQueueReplacer::evict() {
+    if (a1_.empty() && am_.empty()) return npos;
+    if (!a1_.empty() && (a1_resident_ > entries_.size() / 4 || am_.empty()))
+        return evict_from(a1_);
+    return evict_from(am_);
+}
+
+/* Evict the Frame at the back of queue. If it was on probation in a1_ then its
+ * page is remembered in a1_out_, forgetting the oldest ghost if full. */
+std::size_t TwoQueueReplacer::evict_from(std::list<std::size_t>& queue) {
+    const std::size_t fid = queue.back();
+    queue.pop_back();
+    Entry& entry = entries_[fid];
+    entry.queued = false;
+    entry.resident = false;
+    if (entry.hot) return fid;
+    a1_resident_--;
+    if (entry.page == NO_PAGE_) return fid;
+    a1_out_.push_front(entry.page);
+    ghosts_[entry.page] = a1_out_.begin();
+    if (a1_out_.size() > entries_.size() / 2) {
+        ghosts_.erase(a1_out_.back());
+        a1_out_.pop_back();
+    }
+    return fid;
+}
+
+// Return the Frames in am_ and then those in a1_, each most recent first.
+std::vector<std::size_t> TwoQueueReplacer::ranked() const {
+    std::vector<std::size_t> fids{am_.begin(), am_.end()};
+    fids.insert(fids.end(), a1_.begin(), a1_.end());
+    return fids;
+}
+
+// Return a Replacer implementing policy over capacity Frames.
+std::unique_ptr<Replacer> make_replacer(
+    CachePolicy policy, std::size_t capacity
+) {
+    switch (policy) {
+        case CachePolicy::LRU:
+            return std::make_unique<LRUReplacer>(capacity);
+        case CachePolicy::CLOCK:
+            return std::make_unique<ClockReplacer>(capacity);
+        case CachePolicy::TWO_QUEUE:
+            return std::make_unique<TwoQueueReplacer>(capacity);
+    }
+    unreachable();
+}
+
+} // namespace minisql
@@ -0,0 +1,154 @@
+#ifndef MINISQL_REPLACER_HPP
+#define MINISQL_REPLACER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "minisql/options.hpp"
+
+namespace minisql {
+
+/* Replacer
+ * Defines the interface for the replacement policy of a Cache. Tracks which
+ * Frames (by index) are evictable, i.e. hold a page that is not pinned, and
+ * chooses which of them to evict. */
+class Replacer {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    virtual ~Replacer() = default;
+
+    // Track Frames up to (but not including) capacity.
+    virtual void resize(std::size_t capacity) = 0;
+
+    /* Record that the Frame at fid has been (pinned and) loaded with the page
+     * identified by page (its page_id_t, and the Cache it belongs to if the
+     * Frames are shared), for policies which distinguish first references
+     * from repeated ones. */
+    virtual void admit(std::size_t /*fid*/, std::uint64_t /*page*/) {}
+
+    // Record that the Frame at fid has been pinned so cannot be evicted.
+    virtual void pin(std::size_t fid) = 0;
+
+    // Record that the Frame at fid has been unpinned so can be evicted.
+    virtual void unpin(std::size_t fid) = 0;
+
+    // Stop tracking the Frame at fid, whose page has been dropped.
+    virtual void remove(std::size_t fid) { pin(fid); }
+
+    /* Choose an evictable Frame, stop tracking it and return its index, or
+     * return npos if there are no evictable Frames. */
+    virtual std::size_t evict() = 0;
+
+    /* Return the indexes of the evictable Frames, those that would be kept
+     * longest first. */
+    virtual std::vector<std::size_t> ranked() const = 0;
+
+    // Return the number of evictable Frames.
+    virtual std::size_t size() const noexcept = 0;
+};
+
+/* LRU Replacer
+ * Evicts the least recently unpinned Frame, kept at the back of a linked
+ * list. */
+class LRUReplacer : public Replacer {
+public:
+    explicit LRUReplacer(std::size_t capacity) { resize(capacity); }
+
+    void resize(std::size_t capacity) override;
+    void pin(std::size_t fid) override;
+    void unpin(std::size_t fid) override;
+    std::size_t evict() override;
+    std::vector<std::size_t> ranked() const override;
+    std::size_t size() const noexcept override { return lru_.size(); }
+
+private:
+    std::list<std::size_t> lru_;
+    std::vector<std::list<std::size_t>::iterator> its_;
+};
+
+/* Clock Replacer
+ * Approximates LRU by sweeping a hand over a flat array of Frame states,
+ * giving each evictable Frame that has been referenced since the last sweep a
+ * second chance. Neither pinning nor unpinning allocates. */
+class ClockReplacer : public Replacer {
+public:
+    explicit ClockReplacer(std::size_t capacity) { resize(capacity); }
+
+    void resize(std::size_t capacity) override;
+    void pin(std::size_t fid) override;
+    void unpin(std::size_t fid) override;
+    std::size_t evict() override;
+    std::vector<std::size_t> ranked() const override;
+    std::size_t size() const noexcept override { return size_; }
+
+private:
+    enum State : std::uint8_t {
+        EVICTABLE = 1 << 0,
+        REFERENCED = 1 << 1,
+    };
+
+    std::vector<std::uint8_t> states_;
+    std::size_t hand_ {0};
+    std::size_t size_ {0};
+};
+
+/* Two Queue Replacer
+ * A simplified 2Q: pages are admitted on probation into a1_ and are only
+ * promoted to the LRU list am_ when referenced again soon after being evicted,
+ * as remembered by the ghost list of pages a1_out_. Pages touched once
+ * (such as by a table scan) therefore cycle through a1_ without displacing the
+ * frequently used pages in am_.
+ * a1_ is preferred for eviction while its Frames make up more than a quarter
+ * of the capacity, and a1_out_ remembers up to half the capacity. */
+class TwoQueueReplacer : public Replacer {
+public:
+    explicit TwoQueueReplacer(std::size_t capacity) { resize(capacity); }
+
+    void resize(std::size_t capacity) override;
+    void admit(std::size_t fid, std::uint64_t page) override;
+    void pin(std::size_t fid) override;
+    void unpin(std::size_t fid) override;
+    void remove(std::size_t fid) override;
+    std::size_t evict() override;
+    std::vector<std::size_t> ranked() const override;
+    std::size_t size() const noexcept override {
+        return a1_.size() + am_.size();
+    }
+
+private:
+    static constexpr std::uint64_t NO_PAGE_ = static_cast<std::uint64_t>(-1);
+
+    struct Entry {
+        std::uint64_t page {NO_PAGE_};
+        bool hot {false};
+        bool resident {false};
+        bool queued {false};
+        std::list<std::size_t>::iterator it;
+    };
+
+    std::size_t evict_from(std::list<std::size_t>& queue);
+    std::list<std::size_t>& queue(const Entry& entry) {
+        return entry.hot ? am_ : a1_;
+    }
+
+    std::vector<Entry> entries_;
+    std::list<std::size_t> a1_;
+    std::list<std::size_t> am_;
+    std::size_t a1_resident_ {0};
+    std::list<std::uint64_t> a1_out_;
+    std::unordered_map<std::uint64_t, std::list<std::uint64_t>::iterator>
+        ghosts_;
+};
+
+std::unique_ptr<Replacer> make_replacer(
+    CachePolicy policy, std::size_t capacity
+);
+
+} // namespace minisql
+
+#endif // MINISQL_REPLACER_HPP
@@ -0,0 +1,33 @@
+#ifndef MINISQL_SCAN_RING_HPP
+#define MINISQL_SCAN_RING_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "frame_manager/cache/buffer_pool.hpp"
+
+namespace minisql {
+
+/* Scan Ring
+ * A small ring of Frames private to one bulk scan. Pages the scan misses are
+ * read into the Frame in the next slot of the ring, giving up the page the
+ * ring last read into it, rather than into a victim chosen from the whole
+ * BufferPool, so that a scan of a large table recycles a few Frames instead
+ * of flooding the pool. The slots start empty and are filled from the pool as
+ * the ring first goes round. See Cache::ring_fid. */
+class ScanRing {
+public:
+    explicit ScanRing(std::size_t size) : fids_(size, BufferPool::NO_FRAME) {}
+
+    std::size_t size() const noexcept { return fids_.size(); }
+
+private:
+    friend class Cache;
+
+    std::vector<BufferPool::frame_id_t> fids_;
+    std::size_t next_ {0};
+};
+
+} // namespace minisql
+
+#endif // MINISQL_SCAN_RING_HPP
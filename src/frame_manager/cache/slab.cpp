@@ -0,0 +1,99 @@
+#include "frame_manager/cache/slab.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "frame_manager/disk_manager/file.hpp"
+#include "platform.hpp"
+
+#ifdef MINISQL_POSIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace minisql {
+
+namespace {
+
+// Round size up to a multiple of alignment (a power of two).
+std::size_t align_up(std::size_t size, std::size_t alignment) {
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+// Round size down to a multiple of alignment (a power of two).
+std::size_t align_down(std::size_t size, std::size_t alignment) {
+    return size & ~(alignment - 1);
+}
+
+} // namespace
+
+/* Allocate size bytes (none if size is 0), zeroed on POSIX platforms.
+ * To align a huge page slab, a huge page more than needed is mapped and the
+ * unaligned ends are unmapped again.
+ * Throws an std::bad_alloc if the memory cannot be allocated. */
+Slab::Slab(std::size_t size, bool huge_pages) : size_{size} {
+    if (!size_) return;
+#ifdef MINISQL_POSIX
+#ifndef MINISQL_HUGE_PAGES
+    huge_pages = false;
+#endif
+    std::size_t length = align_up(size_, DIRECT_IO_ALIGNMENT);
+    if (huge_pages) length = align_up(length, HUGE_PAGE_SIZE_);
+    const std::size_t padding = huge_pages ? HUGE_PAGE_SIZE_ : 0;
+    void* addr = ::mmap(
+        nullptr, length + padding, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+    );
+    if (addr == MAP_FAILED) throw std::bad_alloc();
+    auto* start = static_cast<std::byte*>(addr);
+    if (huge_pages) {
+        auto* aligned = reinterpret_cast<std::byte*>(align_up(
+            reinterpret_cast<std::uintptr_t>(start), HUGE_PAGE_SIZE_
+        ));
+        if (aligned != start) ::munmap(start, aligned - start);
+        const std::size_t tail = padding - (aligned - start);
+        if (tail) ::munmap(aligned + length, tail);
+        start = aligned;
+#ifdef MINISQL_HUGE_PAGES
+        huge_pages_ = !::madvise(start, length, MADV_HUGEPAGE);
+#endif
+    }
+    data_ = start;
+    mapped_size_ = length;
+#else
+    data_ = static_cast<std::byte*>(::operator new(
+        size_, std::align_val_t{DIRECT_IO_ALIGNMENT}
+    ));
+#endif
+}
+
+/* Return the memory behind the size bytes from data (within the Slab) to the
+ * system, as far as it covers whole pages of memory.
+ * Does nothing where unsupported or if using huge pages, which would otherwise
+ * be split up. */
+void Slab::release(std::byte* data, std::size_t size) noexcept {
+#ifdef MINISQL_POSIX
+    if (huge_pages_) return;
+    static const std::size_t page = static_cast<std::size_t>(
+        ::sysconf(_SC_PAGESIZE)
+    );
+    const auto address = reinterpret_cast<std::uintptr_t>(data);
+    const std::uintptr_t start = align_up(address, page);
+    const std::uintptr_t end = align_down(address + size, page);
+    if (start >= end) return;
+    ::madvise(reinterpret_cast<void*>(start), end - start, MADV_DONTNEED);
+#endif
+}
+
+// Release the memory allocated by the constructor.
+Slab::~Slab() {
+    if (!data_) return;
+#ifdef MINISQL_POSIX
+    ::munmap(data_, mapped_size_);
+#else
+    ::operator delete(data_, std::align_val_t{DIRECT_IO_ALIGNMENT});
+#endif
+}
+
+} // namespace minisql
@@ -0,0 +1,45 @@
+#ifndef MINISQL_SLAB_HPP
+#define MINISQL_SLAB_HPP
+
+#include <cstddef>
+
+namespace minisql {
+
+/* Slab
+ * A single contiguous allocation holding the buffers of every Frame
+ * in a Cache, aligned for direct I/O.
+ * On POSIX platforms it is an anonymous mapping, so memory is only committed as
+ * pages are first touched and reserving room for growth costs nothing. If
+ * huge_pages is set then (where supported) it is aligned to a huge page and
+ * advised to be backed by transparent huge pages, reducing TLB misses.
+ * Parts of the Slab no longer in use can be released back to the system,
+ * after which they read as zeroes (or as before) and are committed again when
+ * next written. */
+class Slab {
+public:
+    explicit Slab(std::size_t size, bool huge_pages = false);
+    ~Slab();
+
+    Slab(const Slab&) = delete;
+    Slab& operator=(const Slab&) = delete;
+
+    std::byte* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+
+    void release(std::byte* data, std::size_t size) noexcept;
+
+    // Return true if the Slab was advised to use huge pages.
+    bool huge_pages() const noexcept { return huge_pages_; }
+
+private:
+    static constexpr std::size_t HUGE_PAGE_SIZE_ = 2 * 1024 * 1024;
+
+    std::byte* data_ {nullptr};
+    std::size_t size_;
+    std::size_t mapped_size_ {0};
+    bool huge_pages_ {false};
+};
+
+} // namespace minisql
+
+#endif // MINISQL_SLAB_HPP
@@ -1,48 +1,293 @@
 #include "frame_manager/disk_manager/disk_manager.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <ios>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <vector>
 
+#include "byte_io.hpp"
+#include "compression/lz.hpp"
 #include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/disk_manager/file.hpp"
+#include "frame_manager/disk_manager/io_engine.hpp"
 #include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/disk_manager/stream_file.hpp"
+#include "headers.hpp"
+#include "span.hpp"
 
 namespace minisql {
 
+namespace {
+
+// Return the nanoseconds elapsed since start.
+std::uint64_t elapsed_ns(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start
+    ).count();
+}
+
+} // namespace
+
+/* Constructor for DiskManager.
+ * Throws a DiskException if the size of file does not match page_count.
+ * If mapped is set but file cannot be mapped then pages are only ever read.
+ * If async_io is set but file does not support asynchronous I/O then batches
+ * are transferred synchronously.
+ * extent_pages is clamped to at least one page. */
 DiskManager::DiskManager(
-    std::fstream& file, std::streamoff base_offset,
-    std::size_t page_size, page_id_t page_count
+    File& file, std::streamoff base_offset, std::size_t page_size,
+    page_id_t page_count, bool mapped, bool async_io, page_id_t extent_pages,
+    bool compress
 ) : file_{file}, base_offset_{base_offset}, page_size_{page_size},
-    page_count_{page_count} {
-    file_.seekg(0, std::ios::end);
-    if (file_.tellg() != page_offset(page_count))
-        throw DiskException(page_offset(page_count), file_.tellg());
+    page_count_{page_count}, reserved_count_{page_count},
+    extent_pages_{std::max<page_id_t>(extent_pages, 1)},
+    io_{make_io_engine(file_, async_io)}, compress_{compress},
+    scratch_(page_size) {
+    validate_size();
+    if (mapped) map_ = file_.map(page_offset(page_count_));
+}
+
+// Constructor for DiskManager over a borrowed std::fstream.
+DiskManager::DiskManager(
+    std::fstream& file, std::streamoff base_offset, std::size_t page_size,
+    page_id_t page_count
+) : stream_{std::make_unique<StreamFile>(file)}, file_{*stream_},
+    base_offset_{base_offset}, page_size_{page_size}, page_count_{page_count},
+    reserved_count_{page_count}, extent_pages_{DEFAULT_EXTENT_PAGES},
+    io_{make_io_engine(file_, false)}, compress_{false}, scratch_(page_size) {
+    validate_size();
+}
+
+// Throw a DiskException if the size of file_ does not match page_count_.
+void DiskManager::validate_size() {
+    const std::streamoff size = file_.size();
+    if (size != page_offset(page_count_))
+        throw DiskException(page_offset(page_count_), size);
 }
 
-// Read the page corresponding to pid into dst.
+/* Read the page corresponding to pid into dst, decompressing it if needed.
+ * If compressing, the first unit of the page is read on its own, and then only
+ * as much more as was stored if the page is compressed. */
 void DiskManager::read(page_id_t pid, std::byte* dst) {
+    std::lock_guard lock{mutex_};
     const std::streamoff offset = page_offset(pid);
     if (pid >= page_count_)
         throw DiskException(offset, page_offset(page_count_));
-    file_.seekg(offset);
-    file_.read(reinterpret_cast<char*>(dst), page_size_);
+    const std::size_t unit = stored_unit();
+    if (!compress_ || page_size_ <= unit) {
+        file_.read(offset, dst, page_size_);
+        decode(dst);
+        return;
+    }
+    file_.read(offset, dst, unit);
+    std::size_t size = page_size_;
+    if (static_cast<Magic>(dst[0]) == Magic::COMPRESSED_PAGE) {
+        const std::size_t compressed = byte_io::view<
+            CompressedPageHeader::compressed_size_t
+        >(span<std::byte>{dst, unit},
+            CompressedPageHeader::COMPRESSED_SIZE_OFFSET);
+        size = std::min(
+            (CompressedPageHeader::SIZE + compressed + unit - 1) / unit * unit,
+            page_size_
+        );
+    }
+    if (size > unit) file_.read(offset + unit, dst + unit, size - unit);
+    decode(dst);
 }
 
-// Write src into the page corresponding to pid.
+/* Write src into the page corresponding to pid.
+ * If src is compressed then only its stored part is written and the rest of
+ * the page is discarded. */
 void DiskManager::write(page_id_t pid, const std::byte* src) {
+    std::lock_guard lock{mutex_};
+    write_page(pid, src);
+}
+
+// Write src into the page corresponding to pid, without locking mutex_.
+void DiskManager::write_page(page_id_t pid, const std::byte* src) {
     const std::streamoff offset = page_offset(pid);
     if (pid >= page_count_)
         throw DiskException(offset, page_offset(page_count_));
-    file_.seekp(offset);
-    file_.write(reinterpret_cast<const char*>(src), page_size_);
+    const std::size_t stored = encode(src);
+    if (!stored) {
+        file_.write(offset, src, page_size_);
+        return;
+    }
+    file_.write(offset, scratch_.data(), stored);
+    file_.discard(offset + stored, page_size_ - stored);
+}
+
+/* Write each of the given pages from its buffer.
+ * The pages are sorted by page_id_t and each run of adjacent pages is written
+ * with a single vectored write (or, if compressing, each page is written on its
+ * own). Returns the syscalls and bytes used.
+ * Throws a DiskException if any page is beyond the end of file_. */
+WriteStats DiskManager::write(span<PageBuffer> pages) {
+    std::sort(pages.begin(), pages.end(),
+        [](const PageBuffer& a, const PageBuffer& b) { return a.pid < b.pid; }
+    );
+    std::lock_guard lock{mutex_};
+    WriteStats stats;
+    if (compress_) {
+        for (const PageBuffer& page : pages) {
+            write_page(page.pid, page.data);
+            stats.syscalls++;
+            stats.bytes += page_size_;
+        }
+        return stats;
+    }
+    std::vector<const std::byte*> run;
+    for (std::size_t i = 0; i < pages.size(); i++) {
+        const page_id_t pid = pages[i].pid;
+        if (pid >= page_count_)
+            throw DiskException(page_offset(pid), page_offset(page_count_));
+        run.push_back(pages[i].data);
+        if (i + 1 < pages.size() && pages[i + 1].pid == pid + 1) continue;
+
+        const page_id_t first = pid + 1 - run.size();
+        stats.syscalls += file_.writev(page_offset(first), run, page_size_);
+        stats.bytes += run.size() * page_size_;
+        run.clear();
+    }
+    return stats;
 }
 
-// Extend file_ by one page.
+/* Extend file_ by one zeroed page.
+ * Preallocates the next extent of file_ once the current one is used up, and
+ * grows the mapping of file_ if it no longer covers every page. */
 void DiskManager::extend() {
-    std::vector<char> zeros(page_size_);
-    file_.seekp(0, std::ios::end);
-    file_.write(zeros.data(), page_size_);
+    std::lock_guard lock{mutex_};
+    if (page_count_ == reserved_count_) {
+        reserved_count_ += extent_pages_;
+        file_.reserve(page_offset(reserved_count_));
+    }
+    file_.resize(page_offset(page_count_ + 1));
     page_count_++;
+    if (map_) map_ = file_.map(page_offset(page_count_));
+}
+
+/* Submit reads of the given pages into their buffers.
+ * The buffers must not be accessed until wait() has returned. */
+void DiskManager::read_async(span<PageBuffer> pages) {
+    std::lock_guard lock{mutex_};
+    submit(IORequest::Type::READ, pages);
+}
+
+/* Submit writes of the given pages from their buffers.
+ * The buffers must not be modified until wait() has returned. */
+void DiskManager::write_async(span<PageBuffer> pages) {
+    std::lock_guard lock{mutex_};
+    submit(IORequest::Type::WRITE, pages);
+}
+
+/* Wait for every submitted transfer to complete, then decompress any pages
+ * that were read compressed. */
+void DiskManager::wait() {
+    std::lock_guard lock{mutex_};
+    io_->wait();
+    for (const PageBuffer& page : pending_reads_) decode(page.data);
+    pending_reads_.clear();
+}
+
+/* Submit a batch of transfers of the given type to io_.
+ * Pages read are remembered so that wait() can decompress them. If
+ * compressing, writes are instead carried out immediately by write().
+ * Throws a DiskException if any page is beyond the end of file_. */
+void DiskManager::submit(IORequest::Type type, span<PageBuffer> pages) {
+    if (pages.empty()) return;
+    if (compress_ && type == IORequest::Type::WRITE) {
+        for (const PageBuffer& page : pages) write_page(page.pid, page.data);
+        return;
+    }
+    std::vector<IORequest> requests;
+    requests.reserve(pages.size());
+    for (const PageBuffer& page : pages) {
+        const std::streamoff offset = page_offset(page.pid);
+        if (page.pid >= page_count_)
+            throw DiskException(offset, page_offset(page_count_));
+        requests.push_back({type, offset, page.data, page_size_});
+    }
+    io_->submit(requests);
+    if (type == IORequest::Type::READ)
+        pending_reads_.insert(pending_reads_.end(), pages.begin(), pages.end());
+}
+
+/* Compress the leaf page src into scratch_ if compress_ is set.
+ * Returns the number of bytes of scratch_ to store (rounded up to a
+ * stored_unit), or 0 if src should be stored as is because it is not a leaf or
+ * would not save at least one unit. */
+std::size_t DiskManager::encode(const std::byte* src) {
+    if (!compress_ || static_cast<Magic>(src[0]) != Magic::LEAF_NODE)
+        return 0;
+    const std::size_t unit = stored_unit();
+    if (page_size_ <= unit + CompressedPageHeader::SIZE) return 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t capacity = std::min<std::size_t>(
+        page_size_ - unit - CompressedPageHeader::SIZE,
+        std::numeric_limits<CompressedPageHeader::compressed_size_t>::max()
+    );
+    const std::size_t size = lz::compress(
+        src, page_size_, scratch_.data() + CompressedPageHeader::SIZE, capacity
+    );
+    compression_stats_.compress_ns += elapsed_ns(start);
+    if (!size) return 0;
+
+    byte_io::write<Magic>(
+        scratch_, CompressedPageHeader::MAGIC_OFFSET, Magic::COMPRESSED_PAGE
+    );
+    byte_io::write<CompressedPageHeader::compressed_size_t>(
+        scratch_, CompressedPageHeader::COMPRESSED_SIZE_OFFSET,
+        static_cast<CompressedPageHeader::compressed_size_t>(size)
+    );
+    const std::size_t stored =
+        (CompressedPageHeader::SIZE + size + unit - 1) / unit * unit;
+    compression_stats_.pages_compressed++;
+    compression_stats_.page_bytes += page_size_;
+    compression_stats_.stored_bytes += stored;
+    return stored;
+}
+
+/* Decompress page in place if compress_ is set and it holds a compressed
+ * page.
+ * Throws a CompressionException if the compressed page is corrupt. */
+void DiskManager::decode(std::byte* page) {
+    if (!compress_ || static_cast<Magic>(page[0]) != Magic::COMPRESSED_PAGE)
+        return;
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t size = byte_io::view<
+        CompressedPageHeader::compressed_size_t
+    >(span<std::byte>{page, page_size_},
+        CompressedPageHeader::COMPRESSED_SIZE_OFFSET);
+    if (size > page_size_ - CompressedPageHeader::SIZE)
+        throw CompressionException("compressed size exceeds page");
+    lz::decompress(
+        page + CompressedPageHeader::SIZE, size, scratch_.data(), page_size_
+    );
+    std::memcpy(page, scratch_.data(), page_size_);
+    compression_stats_.pages_decompressed++;
+    compression_stats_.decompress_ns += elapsed_ns(start);
+}
+
+/* Return a pointer to the page corresponding to pid within the mapping of
+ * file_, or nullptr if file_ is not mapped or the page is compressed.
+ * The page must not be written to through the returned pointer. */
+std::byte* DiskManager::map(page_id_t pid) const {
+    if (!map_) return nullptr;
+    const std::streamoff offset = page_offset(pid);
+    if (pid >= page_count_)
+        throw DiskException(offset, page_offset(page_count_));
+    std::byte* page = map_ + offset;
+    if (compress_ && static_cast<Magic>(page[0]) == Magic::COMPRESSED_PAGE)
+        return nullptr;
+    return page;
 }
 
 } // namespace minisql
\ No newline at end of file
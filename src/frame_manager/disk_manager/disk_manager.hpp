@@ -2,17 +2,68 @@
 #define MINISQL_DISK_MANAGER_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <fstream>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <vector>
 
+#include "frame_manager/disk_manager/file.hpp"
+#include "frame_manager/disk_manager/io_engine.hpp"
 #include "frame_manager/disk_manager/page_id_t.hpp"
+#include "span.hpp"
 
 namespace minisql {
 
+// A page and the buffer it is transferred to or from.
+struct PageBuffer {
+    page_id_t pid;
+    std::byte* data;
+};
+
+// The cost of writing a batch of pages.
+struct WriteStats {
+    std::size_t syscalls {0};
+    std::size_t bytes {0};
+};
+
+/* Counters for page compression.
+ * The compression ratio is page_bytes / stored_bytes. */
+struct CompressionStats {
+    std::uint64_t pages_compressed {0};
+    std::uint64_t pages_decompressed {0};
+    std::uint64_t page_bytes {0};
+    std::uint64_t stored_bytes {0};
+    std::uint64_t compress_ns {0};
+    std::uint64_t decompress_ns {0};
+};
+
 /* DiskManager
- * Reads pages from and writes pages to the file with given path.
- * page_id_t = 0 corresponds to the page starting from base_offset. */
+ * Reads pages from and writes pages to the given File.
+ * page_id_t = 0 corresponds to the page starting from base_offset.
+ * If mapped, pages can also be viewed in place within a read-only mapping of
+ * the File.
+ * Batches of pages can be transferred asynchronously through an IOEngine.
+ * The File grows one page at a time, but storage for it is preallocated in
+ * extents of extent_pages pages so that the File size always matches
+ * page_count.
+ * If compress is set then leaf pages are written lz-compressed at the start
+ * of their slot, behind a CompressedPageHeader, and the rest of the slot is
+ * discarded, and compressed pages are decompressed when read. Reading a page
+ * on its own then transfers only its stored part, while batches read whole
+ * pages. A File written with compress set must be read with it set too.
+ * Pages may be written from a background thread while the owning thread uses
+ * the DiskManager, so transfers and growth of the File are serialised. */
 class DiskManager {
 public:
+    static constexpr page_id_t DEFAULT_EXTENT_PAGES = 64;
+
+    DiskManager(
+        File& file, std::streamoff base_offset, std::size_t page_size,
+        page_id_t page_count, bool mapped = false, bool async_io = false,
+        page_id_t extent_pages = DEFAULT_EXTENT_PAGES, bool compress = false
+    );
     DiskManager(
         std::fstream& file, std::streamoff base_offset,
         std::size_t page_size, page_id_t page_count
@@ -24,20 +75,61 @@ public:
 
     void read(page_id_t pid, std::byte* dst);
     void write(page_id_t pid, const std::byte* src);
+    WriteStats write(span<PageBuffer> pages);
     void extend();
-    
+
+    void read_async(span<PageBuffer> pages);
+    void write_async(span<PageBuffer> pages);
+    void wait();
+    bool async() const noexcept { return io_->async(); }
+
+    std::byte* map(page_id_t pid) const;
+    bool mapped() const noexcept { return map_; }
+
     std::size_t page_size() const noexcept { return page_size_; }
     page_id_t page_count() const noexcept { return page_count_; }
 
+    // Return a copy of the compression counters, taken under mutex_.
+    CompressionStats compression_stats() const {
+        std::lock_guard lock{mutex_};
+        return compression_stats_;
+    }
+
 private:
-    std::fstream& file_;
+    std::unique_ptr<File> stream_;
+    File& file_;
     const std::streamoff base_offset_;
     const std::size_t page_size_;
     page_id_t page_count_;
+    page_id_t reserved_count_;
+    const page_id_t extent_pages_;
+    std::byte* map_ {nullptr};
+    std::unique_ptr<IOEngine> io_;
+    const bool compress_;
+    CompressionStats compression_stats_;
+    std::vector<std::byte> scratch_;
+    std::vector<PageBuffer> pending_reads_;
+    mutable std::mutex mutex_;
 
     std::streamoff page_offset(page_id_t pid) const {
         return base_offset_ + page_size_ * pid;
     }
+
+    /* Granularity of the stored part of a compressed page: a sector, or
+     * DIRECT_IO_ALIGNMENT if file_ is direct. */
+    std::size_t stored_unit() const noexcept {
+        return file_.direct() ? DIRECT_IO_ALIGNMENT : SECTOR_SIZE_;
+    }
+
+    void validate_size();
+    void write_page(page_id_t pid, const std::byte* src);
+    void submit(IORequest::Type type, span<PageBuffer> pages);
+    std::size_t encode(const std::byte* src);
+    void decode(std::byte* page);
+
+    // Granularity of the stored part of a compressed page.
+    static constexpr std::size_t SECTOR_SIZE_ = 512;
+
 };
 
 } // namespace minisql
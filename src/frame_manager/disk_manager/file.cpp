@@ -0,0 +1,41 @@
+#include "frame_manager/disk_manager/file.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <ios>
+#include <memory>
+
+#include "frame_manager/disk_manager/positional_file.hpp"
+#include "frame_manager/disk_manager/stream_file.hpp"
+#include "platform.hpp"
+#include "span.hpp"
+
+namespace minisql {
+
+/* Write the size bytes from each of srcs one after another starting at offset.
+ * Returns the number of writes issued, which is one per src unless
+ * overridden with a vectored write. */
+std::size_t File::writev(
+    std::streamoff offset, span<const std::byte*> srcs, std::size_t size
+) {
+    for (const std::byte* src : srcs) {
+        write(offset, src, size);
+        offset += size;
+    }
+    return srcs.size();
+}
+
+/* Open (creating if necessary) the file with given path using the given
+ * backend, for direct I/O if direct is set and the backend supports it.
+ * Falls back to a StreamFile on platforms without positional I/O. */
+std::unique_ptr<File> open_file(
+    const std::filesystem::path& path, FileBackend backend, bool direct
+) {
+#ifdef MINISQL_POSIX
+    if (backend == FileBackend::POSITIONAL)
+        return std::make_unique<PositionalFile>(path, direct);
+#endif
+    return std::make_unique<StreamFile>(path);
+}
+
+} // namespace minisql
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef MINISQL_FILE_HPP
+#define MINISQL_FILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <ios>
+#include <memory>
+
+#include "span.hpp"
+
+namespace minisql {
+
+// Alignment of the offsets, sizes and buffers of direct I/O transfers.
+inline constexpr std::size_t DIRECT_IO_ALIGNMENT = 4096;
+
+/* File
+ * Defines the interface for the raw storage underlying a DiskManager. All
+ * transfers are positioned by an absolute byte offset. */
+class File {
+public:
+    virtual ~File() = default;
+
+    virtual void read(std::streamoff offset, std::byte* dst, std::size_t size)
+        = 0;
+    virtual void write(
+        std::streamoff offset, const std::byte* src, std::size_t size
+    ) = 0;
+    virtual std::size_t writev(
+        std::streamoff offset, span<const std::byte*> srcs, std::size_t size
+    );
+
+    virtual std::streamoff size() = 0;
+    virtual void flush() = 0;
+
+    // Grow the file to size bytes, filling the new bytes with zeros.
+    virtual void resize(std::streamoff size) = 0;
+
+    /* Preallocate storage for the first size bytes of the file without
+     * changing size() (does nothing where unsupported). */
+    virtual void reserve(std::streamoff /*size*/) {}
+
+    /* Release the storage behind size bytes starting from offset, whose
+     * contents are no longer needed (does nothing where unsupported). */
+    virtual void discard(std::streamoff /*offset*/, std::size_t /*size*/) {}
+
+    /* Return the start of a read-only mapping of at least the first length
+     * bytes of the file, or nullptr if the File cannot be mapped. */
+    virtual std::byte* map(std::streamoff /*length*/) { return nullptr; }
+
+    // Return the underlying file descriptor, or -1 if there is none.
+    virtual int descriptor() const { return -1; }
+
+    // Return true if transfers bypass the kernel page cache.
+    virtual bool direct() const noexcept { return false; }
+};
+
+/* File Backend
+ * Selects the File implementation used to access a database. */
+enum class FileBackend {
+    STREAM,         // std::fstream with a seek before every transfer
+    POSITIONAL,     // raw file descriptor with pread/pwrite (POSIX only)
+};
+
+std::unique_ptr<File> open_file(
+    const std::filesystem::path& path, FileBackend backend, bool direct = false
+);
+
+} // namespace minisql
+
+#endif // MINISQL_FILE_HPP
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "frame_manager/disk_manager/io_engine.hpp"
+
+#include <memory>
+
+#include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/disk_manager/file.hpp"
+#include "frame_manager/disk_manager/io_uring_engine.hpp"
+#include "platform.hpp"
+#include "span.hpp"
+
+namespace minisql {
+
+// Carry out each request in order.
+void SyncIOEngine::submit(span<IORequest> requests) {
+    for (const IORequest& request : requests) {
+        if (request.type == IORequest::Type::READ)
+            file_.read(request.offset, request.data, request.size);
+        else file_.write(request.offset, request.data, request.size);
+    }
+}
+
+/* Return an IOEngine for file.
+ * If async is set then an IOUringEngine is returned where io_uring is
+ * available for file, otherwise falls back to a SyncIOEngine. */
+std::unique_ptr<IOEngine> make_io_engine(File& file, bool async) {
+#ifdef MINISQL_IO_URING
+    if (async && file.descriptor() >= 0) {
+        try { return std::make_unique<IOUringEngine>(file); }
+        catch (const FileIOException&) {}
+    }
+#endif
+    return std::make_unique<SyncIOEngine>(file);
+}
+
+} // namespace minisql
@@ -0,0 +1,58 @@
+#ifndef MINISQL_IO_ENGINE_HPP
+#define MINISQL_IO_ENGINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+#include <memory>
+
+#include "frame_manager/disk_manager/file.hpp"
+#include "span.hpp"
+
+namespace minisql {
+
+// A transfer of size bytes between data and a File at offset.
+struct IORequest {
+    enum class Type : std::uint8_t { READ, WRITE };
+
+    Type type;
+    std::streamoff offset;
+    std::byte* data;
+    std::size_t size;
+};
+
+/* IO Engine
+ * Carries out batches of IORequests on a File. A batch is submitted together
+ * and may complete asynchronously, so the buffers of submitted requests must
+ * not be touched until wait() has returned. */
+class IOEngine {
+public:
+    virtual ~IOEngine() = default;
+
+    virtual void submit(span<IORequest> requests) = 0;
+    virtual void wait() = 0;
+
+    // Return true if the engine completes requests asynchronously.
+    virtual bool async() const noexcept = 0;
+};
+
+/* Sync IO Engine
+ * Carries out each IORequest immediately on submission. */
+class SyncIOEngine : public IOEngine {
+public:
+    explicit SyncIOEngine(File& file) : file_{file} {}
+
+    void submit(span<IORequest> requests) override;
+    void wait() override {}
+
+    bool async() const noexcept override { return false; }
+
+private:
+    File& file_;
+};
+
+std::unique_ptr<IOEngine> make_io_engine(File& file, bool async);
+
+} // namespace minisql
+
+#endif // MINISQL_IO_ENGINE_HPP
@@ -0,0 +1,201 @@
+#include "frame_manager/disk_manager/io_uring_engine.hpp"
+
+#ifdef MINISQL_IO_URING
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/disk_manager/file.hpp"
+#include "span.hpp"
+
+namespace minisql {
+
+namespace {
+
+template <typename T>
+T* at(void* base, std::uint32_t offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+} // namespace
+
+/* Set up an io_uring instance with the given number of entries and map its
+ * rings into memory. */
+IOUringEngine::IOUringEngine(File& file, unsigned entries) : file_{file} {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ring_fd_ = static_cast<int>(
+        ::syscall(__NR_io_uring_setup, entries, &params)
+    );
+    if (ring_fd_ < 0)
+        throw FileIOException("set up io_uring for", 0, std::strerror(errno));
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes +
+        params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap)
+        sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+
+    sq_ring_ = ::mmap(
+        nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING
+    );
+    cq_ring_ = single_mmap ? sq_ring_ : ::mmap(
+        nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING
+    );
+    void* sqes = ::mmap(
+        nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES
+    );
+    if (sq_ring_ == MAP_FAILED || cq_ring_ == MAP_FAILED ||
+        sqes == MAP_FAILED) {
+        const std::string reason = std::strerror(errno);
+        if (sq_ring_ != MAP_FAILED) ::munmap(sq_ring_, sq_ring_size_);
+        if (!single_mmap && cq_ring_ != MAP_FAILED)
+            ::munmap(cq_ring_, cq_ring_size_);
+        if (sqes != MAP_FAILED) ::munmap(sqes, sqes_size_);
+        ::close(ring_fd_);
+        throw FileIOException("map io_uring for", 0, reason);
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    sq_tail_ = at<unsigned>(sq_ring_, params.sq_off.tail);
+    sq_mask_ = at<unsigned>(sq_ring_, params.sq_off.ring_mask);
+    sq_array_ = at<unsigned>(sq_ring_, params.sq_off.array);
+    sq_entries_ = params.sq_entries;
+    cq_head_ = at<unsigned>(cq_ring_, params.cq_off.head);
+    cq_tail_ = at<unsigned>(cq_ring_, params.cq_off.tail);
+    cq_mask_ = at<unsigned>(cq_ring_, params.cq_off.ring_mask);
+    cqes_ = at<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+
+    slots_.resize(sq_entries_);
+    free_slots_.reserve(sq_entries_);
+    for (unsigned slot = sq_entries_; slot-- > 0;) free_slots_.push_back(slot);
+}
+
+// Wait for any requests in flight before tearing down the rings.
+IOUringEngine::~IOUringEngine() {
+    try { wait(); }
+    catch (const FileIOException&) {}
+    ::munmap(sqes_, sqes_size_);
+    if (cq_ring_ != sq_ring_) ::munmap(cq_ring_, cq_ring_size_);
+    ::munmap(sq_ring_, sq_ring_size_);
+    ::close(ring_fd_);
+}
+
+/* Queue every request and submit them together.
+ * If the ring fills up then the queued requests are submitted and the oldest
+ * completions are reaped before continuing. */
+void IOUringEngine::submit(span<IORequest> requests) {
+    const int fd = file_.descriptor();
+    for (const IORequest& request : requests) {
+        if (free_slots_.empty()) {
+            enter(1);
+            reap();
+        }
+        const unsigned slot = free_slots_.back();
+        free_slots_.pop_back();
+        slots_[slot] = request;
+
+        const unsigned tail = *sq_tail_;
+        const unsigned index = tail & *sq_mask_;
+        io_uring_sqe& sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = request.type == IORequest::Type::READ ?
+            IORING_OP_READ : IORING_OP_WRITE;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<std::uint64_t>(request.data);
+        sqe.len = static_cast<std::uint32_t>(request.size);
+        sqe.off = static_cast<std::uint64_t>(request.offset);
+        sqe.user_data = slot;
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        queued_++;
+    }
+    enter(0);
+}
+
+// Wait for every submitted request to complete.
+void IOUringEngine::wait() {
+    while (free_slots_.size() != sq_entries_) {
+        enter(1);
+        reap();
+    }
+}
+
+/* Submit any queued sqes and wait for at least min_complete completions.
+ * Throws a FileIOException if the syscall fails. */
+void IOUringEngine::enter(unsigned min_complete) {
+    while (queued_ || min_complete) {
+        const unsigned flags = min_complete ? IORING_ENTER_GETEVENTS : 0;
+        const long submitted = ::syscall(
+            __NR_io_uring_enter, ring_fd_, queued_, min_complete, flags,
+            nullptr, 0
+        );
+        if (submitted < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EBUSY) {
+                reap();
+                continue;
+            }
+            throw FileIOException("submit io_uring for", 0,
+                std::strerror(errno));
+        }
+        queued_ -= static_cast<unsigned>(submitted);
+        min_complete = 0;
+    }
+}
+
+/* Consume all available completions, releasing their slots.
+ * Failed or partial transfers are finished synchronously. */
+void IOUringEngine::reap() {
+    unsigned head = *cq_head_;
+    const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        const io_uring_cqe& cqe = cqes_[head & *cq_mask_];
+        const unsigned slot = static_cast<unsigned>(cqe.user_data);
+        const int res = cqe.res;
+        head++;
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        free_slots_.push_back(slot);
+        finish(slots_[slot], res);
+    }
+}
+
+/* Finish any part of request that the kernel did not transfer.
+ * Falls back to the File if the operation was rejected, and throws a
+ * FileIOException on any other error. */
+void IOUringEngine::finish(const IORequest& request, int res) {
+    if (res < 0 && res != -EINVAL && res != -EOPNOTSUPP && res != -EAGAIN &&
+        res != -EINTR)
+        throw FileIOException(
+            request.type == IORequest::Type::READ ? "read" : "write",
+            request.offset, std::strerror(-res)
+        );
+    const std::size_t done = res < 0 ? 0 : static_cast<std::size_t>(res);
+    if (done == request.size) return;
+    if (request.type == IORequest::Type::READ)
+        file_.read(
+            request.offset + done, request.data + done, request.size - done
+        );
+    else file_.write(
+        request.offset + done, request.data + done, request.size - done
+    );
+}
+
+} // namespace minisql
+
+#endif // MINISQL_IO_URING
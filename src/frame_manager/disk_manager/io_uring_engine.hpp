@@ -0,0 +1,74 @@
+#ifndef MINISQL_IO_URING_ENGINE_HPP
+#define MINISQL_IO_URING_ENGINE_HPP
+
+#include "platform.hpp"
+
+#ifdef MINISQL_IO_URING
+
+#include <cstddef>
+#include <vector>
+
+#include <linux/io_uring.h>
+
+#include "frame_manager/disk_manager/file.hpp"
+#include "frame_manager/disk_manager/io_engine.hpp"
+#include "span.hpp"
+
+namespace minisql {
+
+/* IO Uring Engine
+ * An IOEngine driving an io_uring instance through raw syscalls. A batch of
+ * requests is queued and submitted with a single syscall, then reaped in
+ * wait(). Requests the kernel cannot carry out (or only partially carries out)
+ * are finished synchronously on the File.
+ * Throws a FileIOException on construction if io_uring is unavailable. */
+class IOUringEngine : public IOEngine {
+public:
+    explicit IOUringEngine(File& file, unsigned entries = DEFAULT_ENTRIES_);
+    ~IOUringEngine() override;
+
+    IOUringEngine(const IOUringEngine&) = delete;
+    IOUringEngine& operator=(const IOUringEngine&) = delete;
+
+    void submit(span<IORequest> requests) override;
+    void wait() override;
+
+    bool async() const noexcept override { return true; }
+
+private:
+    File& file_;
+    int ring_fd_;
+
+    void* sq_ring_ {nullptr};
+    std::size_t sq_ring_size_;
+    void* cq_ring_ {nullptr};
+    std::size_t cq_ring_size_;
+    io_uring_sqe* sqes_ {nullptr};
+    std::size_t sqes_size_;
+
+    unsigned* sq_tail_;
+    unsigned* sq_mask_;
+    unsigned* sq_array_;
+    unsigned sq_entries_;
+    unsigned* cq_head_;
+    unsigned* cq_tail_;
+    unsigned* cq_mask_;
+    io_uring_cqe* cqes_;
+
+    // Requests in flight, indexed by the user_data of their sqe.
+    std::vector<IORequest> slots_;
+    std::vector<unsigned> free_slots_;
+    unsigned queued_ {0};
+
+    void enter(unsigned min_complete);
+    void reap();
+    void finish(const IORequest& request, int res);
+
+    static constexpr unsigned DEFAULT_ENTRIES_ = 64;
+};
+
+} // namespace minisql
+
+#endif // MINISQL_IO_URING
+
+#endif // MINISQL_IO_URING_ENGINE_HPP
@@ -0,0 +1,66 @@
+#include "frame_manager/disk_manager/memory_file.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <ios>
+#include <memory>
+
+#include "exceptions/engine_exceptions.hpp"
+
+namespace minisql {
+
+/* Read size bytes starting from offset into dst.
+ * Throws a FileIOException if the range extends beyond the end of the file. */
+void MemoryFile::read(std::streamoff offset, std::byte* dst, std::size_t size)
+{
+    if (offset + static_cast<std::streamoff>(size) > size_)
+        throw FileIOException("read", offset, "end of file");
+    while (size) {
+        const std::size_t block = offset / BLOCK_SIZE_;
+        const std::size_t start = offset % BLOCK_SIZE_;
+        const std::size_t n = std::min(size, BLOCK_SIZE_ - start);
+        if (block < blocks_.size() && blocks_[block])
+            std::memcpy(dst, blocks_[block].get() + start, n);
+        else std::memset(dst, 0, n);
+        offset += n;
+        dst += n;
+        size -= n;
+    }
+}
+
+/* Write size bytes from src starting at offset, allocating (zeroed) blocks of
+ * storage as needed.
+ * Throws a FileIOException if the range extends beyond the end of the file. */
+void MemoryFile::write(
+    std::streamoff offset, const std::byte* src, std::size_t size
+) {
+    if (offset + static_cast<std::streamoff>(size) > size_)
+        throw FileIOException("write", offset, "end of file");
+    while (size) {
+        const std::size_t block = offset / BLOCK_SIZE_;
+        const std::size_t start = offset % BLOCK_SIZE_;
+        const std::size_t n = std::min(size, BLOCK_SIZE_ - start);
+        if (block >= blocks_.size()) blocks_.resize(block + 1);
+        if (!blocks_[block]) {
+            blocks_[block] = std::make_unique<std::byte[]>(BLOCK_SIZE_);
+            allocated_ += BLOCK_SIZE_;
+        }
+        std::memcpy(blocks_[block].get() + start, src, n);
+        offset += n;
+        src += n;
+        size -= n;
+    }
+}
+
+/* Grow the file to size bytes. No storage is allocated until the new bytes
+ * are written.
+ * Does nothing if the file is already at least size bytes.
+ * Throws a MemoryLimitException if size exceeds limit_. */
+void MemoryFile::resize(std::streamoff size) {
+    if (size <= size_) return;
+    if (size > limit_) throw MemoryLimitException(limit_);
+    size_ = size;
+}
+
+} // namespace minisql
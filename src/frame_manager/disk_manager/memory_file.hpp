@@ -0,0 +1,50 @@
+#ifndef MINISQL_MEMORY_FILE_HPP
+#define MINISQL_MEMORY_FILE_HPP
+
+#include <cstddef>
+#include <ios>
+#include <memory>
+#include <vector>
+
+#include "frame_manager/disk_manager/file.hpp"
+
+namespace minisql {
+
+/* Memory File
+ * A File held entirely in process memory, for databases that are never
+ * persisted. Storage is allocated in blocks on first write so that space
+ * which is only ever read (or only ever cached) costs nothing, and bytes that
+ * were never written read as zeros.
+ * Growing beyond limit bytes throws a MemoryLimitException. */
+class MemoryFile : public File {
+public:
+    explicit MemoryFile(std::streamoff limit) : limit_{limit} {}
+
+    MemoryFile(const MemoryFile&) = delete;
+    MemoryFile& operator=(const MemoryFile&) = delete;
+
+    void read(std::streamoff offset, std::byte* dst, std::size_t size)
+        override;
+    void write(std::streamoff offset, const std::byte* src, std::size_t size)
+        override;
+
+    std::streamoff size() override { return size_; }
+    void flush() override {}
+
+    void resize(std::streamoff size) override;
+
+    // Return the number of bytes of storage allocated for written blocks.
+    std::size_t allocated() const noexcept { return allocated_; }
+
+private:
+    static constexpr std::size_t BLOCK_SIZE_ = 4096;
+
+    const std::streamoff limit_;
+    std::streamoff size_ {0};
+    std::vector<std::unique_ptr<std::byte[]>> blocks_;
+    std::size_t allocated_ {0};
+};
+
+} // namespace minisql
+
+#endif // MINISQL_MEMORY_FILE_HPP
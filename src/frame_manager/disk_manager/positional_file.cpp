@@ -0,0 +1,293 @@
+#include "frame_manager/disk_manager/positional_file.hpp"
+
+#ifdef MINISQL_POSIX
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <ios>
+#include <new>
+#include <vector>
+
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/disk_manager/file.hpp"
+#include "span.hpp"
+
+namespace minisql {
+
+namespace {
+
+constexpr int OPEN_FLAGS = O_RDWR | O_CREAT | O_CLOEXEC;
+
+// Buffer aligned for direct I/O.
+struct AlignedBuffer {
+    explicit AlignedBuffer(std::size_t size)
+        : data{static_cast<std::byte*>(::operator new(
+            size, std::align_val_t{DIRECT_IO_ALIGNMENT}
+        ))} {}
+    ~AlignedBuffer() {
+        ::operator delete(data, std::align_val_t{DIRECT_IO_ALIGNMENT});
+    }
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    std::byte* data;
+};
+
+// Return true if offset, size and buffer are all aligned for direct I/O.
+bool aligned(std::streamoff offset, const std::byte* buffer, std::size_t size)
+{
+    return !(offset % DIRECT_IO_ALIGNMENT) && !(size % DIRECT_IO_ALIGNMENT) &&
+        !(reinterpret_cast<std::uintptr_t>(buffer) % DIRECT_IO_ALIGNMENT);
+}
+
+} // namespace
+
+/* Open the file with given path, creating it first if it does not exist.
+ * If direct is set then the file is opened for direct I/O, bypassing the
+ * kernel page cache (ignored where unsupported).
+ * Throws an std::ios_base::failure if the file cannot be opened. */
+PositionalFile::PositionalFile(const std::filesystem::path& path, bool direct)
+    : fd_{-1} {
+#ifdef MINISQL_DIRECT_IO
+    if (direct) {
+        fd_ = ::open(path.c_str(), OPEN_FLAGS | O_DIRECT, 0644);
+        direct_ = fd_ >= 0;
+    }
+#endif
+    if (fd_ < 0) fd_ = ::open(path.c_str(), OPEN_FLAGS, 0644);
+    if (fd_ < 0) throw std::ios_base::failure(
+        "Failed to open database: " + path.string()
+    );
+}
+
+// Unmap all mappings and close the file.
+PositionalFile::~PositionalFile() {
+    for (const Mapping& m : mappings_) ::munmap(m.addr, m.length);
+    ::close(fd_);
+}
+
+/* Read size bytes starting from offset into dst.
+ * Throws a FileIOException if the read fails or runs past the end of the
+ * file. */
+void PositionalFile::read(
+    std::streamoff offset, std::byte* dst, std::size_t size
+) {
+    if (direct_ && !aligned(offset, dst, size)) {
+        read_unaligned(offset, dst, size);
+        return;
+    }
+    const std::size_t n = read_some(offset, dst, size);
+    if (n < size)
+        throw FileIOException("read", offset + n, "unexpected end of file");
+}
+
+/* Write size bytes from src starting at offset.
+ * Throws a FileIOException if the write fails. */
+void PositionalFile::write(
+    std::streamoff offset, const std::byte* src, std::size_t size
+) {
+    if (direct_ && !aligned(offset, src, size))
+        write_unaligned(offset, src, size);
+    else write_all(offset, src, size);
+}
+
+/* Read up to size bytes starting from offset into dst, stopping early only at
+ * the end of the file. Returns the number of bytes read.
+ * Retries interrupted and partial reads, throws a FileIOException if a read
+ * fails. */
+std::size_t PositionalFile::read_some(
+    std::streamoff offset, std::byte* dst, std::size_t size
+) {
+    std::size_t done = 0;
+    while (done < size) {
+        ssize_t n = ::pread(fd_, dst + done, size - done, offset + done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) throw FileIOException(
+            "read", offset + done, std::strerror(errno)
+        );
+        if (!n) break;
+        done += n;
+    }
+    return done;
+}
+
+/* Write size bytes from src starting at offset.
+ * Retries interrupted and partial writes, throws a FileIOException if a write
+ * fails. */
+void PositionalFile::write_all(
+    std::streamoff offset, const std::byte* src, std::size_t size
+) {
+    while (size) {
+        ssize_t n = ::pwrite(fd_, src, size, offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) throw FileIOException("write", offset, std::strerror(errno));
+        src += n;
+        offset += n;
+        size -= n;
+    }
+}
+
+/* Write the size bytes from each of srcs one after another starting at offset
+ * using pwritev, up to IOV_MAX buffers per syscall.
+ * Falls back to separate writes if direct and any buffer is unaligned.
+ * Retries interrupted and partial writes, throws a FileIOException if a write
+ * fails. Returns the number of syscalls that transferred data, not counting
+ * interrupted ones. */
+std::size_t PositionalFile::writev(
+    std::streamoff offset, span<const std::byte*> srcs, std::size_t size
+) {
+    if (direct_) {
+        for (const std::byte* src : srcs)
+            if (!aligned(offset, src, size))
+                return File::writev(offset, srcs, size);
+    }
+
+    std::vector<iovec> iov;
+    iov.reserve(srcs.size());
+    for (const std::byte* src : srcs)
+        iov.push_back({const_cast<std::byte*>(src), size});
+
+    std::size_t syscalls = 0, next = 0;
+    while (next < iov.size()) {
+        const int count = static_cast<int>(
+            std::min<std::size_t>(iov.size() - next, IOV_MAX)
+        );
+        ssize_t n = ::pwritev(fd_, &iov[next], count, offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) throw FileIOException("write", offset, std::strerror(errno));
+        syscalls++;
+        offset += n;
+        while (n && static_cast<std::size_t>(n) >= iov[next].iov_len) {
+            n -= iov[next].iov_len;
+            next++;
+        }
+        if (n) {
+            iov[next].iov_base = static_cast<char*>(iov[next].iov_base) + n;
+            iov[next].iov_len -= n;
+        }
+    }
+    return syscalls;
+}
+
+/* Read size bytes starting from offset into dst through an aligned buffer
+ * covering every block they overlap, as required for direct I/O.
+ * Throws a FileIOException if the read fails or runs past the end of the
+ * file. */
+void PositionalFile::read_unaligned(
+    std::streamoff offset, std::byte* dst, std::size_t size
+) {
+    const std::streamoff start = offset - offset % DIRECT_IO_ALIGNMENT;
+    const std::size_t length = align_up(offset + size) - start;
+    AlignedBuffer buffer{length};
+    const std::size_t n = read_some(start, buffer.data, length);
+    if (start + static_cast<std::streamoff>(n) <
+        offset + static_cast<std::streamoff>(size))
+        throw FileIOException("read", start + n, "unexpected end of file");
+    std::memcpy(dst, buffer.data + (offset - start), size);
+}
+
+/* Write size bytes from src starting at offset by reading, modifying and
+ * writing back every block they overlap, as required for direct I/O.
+ * The file is truncated back afterwards if the last block overran its end.
+ * Throws a FileIOException if the write fails. */
+void PositionalFile::write_unaligned(
+    std::streamoff offset, const std::byte* src, std::size_t size
+) {
+    const std::streamoff end = std::max<std::streamoff>(
+        this->size(), offset + size
+    );
+    const std::streamoff start = offset - offset % DIRECT_IO_ALIGNMENT;
+    const std::size_t length = align_up(offset + size) - start;
+    AlignedBuffer buffer{length};
+    const std::size_t n = read_some(start, buffer.data, length);
+    std::memset(buffer.data + n, 0, length - n);
+    std::memcpy(buffer.data + (offset - start), src, size);
+    write_all(start, buffer.data, length);
+    if (start + static_cast<std::streamoff>(length) > end) resize(end);
+}
+
+// Return the size of the file in bytes.
+std::streamoff PositionalFile::size() {
+    struct stat st;
+    if (::fstat(fd_, &st) < 0)
+        throw FileIOException("stat", 0, std::strerror(errno));
+    return st.st_size;
+}
+
+/* Grow the file to size bytes.
+ * Throws a FileIOException if the file cannot be resized. */
+void PositionalFile::resize(std::streamoff size) {
+    while (::ftruncate(fd_, size) < 0) {
+        if (errno != EINTR)
+            throw FileIOException("resize", size, std::strerror(errno));
+    }
+}
+
+/* Preallocate blocks for the first size bytes of the file, keeping its size
+ * unchanged so that later growth within them needs no new allocation.
+ * Does nothing where fallocate is unsupported (or fails, as it only ever
+ * speeds up later writes). */
+void PositionalFile::reserve([[maybe_unused]] std::streamoff size) {
+#ifdef MINISQL_FALLOCATE
+    ::fallocate(fd_, FALLOC_FL_KEEP_SIZE, 0, size);
+#endif
+}
+
+/* Punch a hole over the whole blocks within size bytes starting from offset,
+ * keeping the size of the file unchanged.
+ * Does nothing where fallocate is unsupported (or fails, as the bytes are no
+ * longer needed either way). */
+void PositionalFile::discard(
+    [[maybe_unused]] std::streamoff offset, [[maybe_unused]] std::size_t size
+) {
+#ifdef MINISQL_FALLOCATE
+    const std::streamoff start = align_up(offset);
+    const std::streamoff end = (offset + static_cast<std::streamoff>(size)) /
+        DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT;
+    if (start < end)
+        ::fallocate(
+            fd_, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, start, end - start
+        );
+#endif
+}
+
+/* Return the start of a read-only shared mapping of at least the first length
+ * bytes of the file.
+ * A new mapping is only created when length exceeds the current one, and is
+ * made at least twice as long so that growth remaps rarely. Previous mappings
+ * are kept until the PositionalFile is destroyed so that pointers into them
+ * remain valid.
+ * The mapping may extend beyond the end of the file, so only bytes below
+ * size() may be accessed.
+ * Returns nullptr if the file was opened for direct I/O, as a mapping would
+ * go through the page cache it bypasses. */
+std::byte* PositionalFile::map(std::streamoff length) {
+    if (direct_) return nullptr;
+    std::size_t current = mappings_.empty() ? 0 : mappings_.back().length;
+    if (!mappings_.empty() && static_cast<std::size_t>(length) <= current)
+        return mappings_.back().addr;
+    std::size_t new_length = std::max<std::size_t>(
+        {static_cast<std::size_t>(length), current * 2, MIN_MAP_LENGTH_}
+    );
+    void* addr = ::mmap(nullptr, new_length, PROT_READ, MAP_SHARED, fd_, 0);
+    if (addr == MAP_FAILED)
+        throw FileIOException("map", 0, std::strerror(errno));
+    mappings_.push_back({static_cast<std::byte*>(addr), new_length});
+    return mappings_.back().addr;
+}
+
+} // namespace minisql
+
+#endif // MINISQL_POSIX
\ No newline at end of file
@@ -0,0 +1,93 @@
+#ifndef MINISQL_POSITIONAL_FILE_HPP
+#define MINISQL_POSITIONAL_FILE_HPP
+
+#include "platform.hpp"
+
+#ifdef MINISQL_POSIX
+
+#include <cstddef>
+#include <filesystem>
+#include <ios>
+#include <vector>
+
+#include "frame_manager/disk_manager/file.hpp"
+#include "span.hpp"
+
+namespace minisql {
+
+/* Positional File
+ * A File over a raw file descriptor. Transfers use pread/pwrite, so each is a
+ * single syscall with no intermediate stream buffer and no shared file
+ * position, making concurrent transfers safe.
+ * The file can also be mapped into memory for reading, and storage can be
+ * preallocated ahead of its growth where fallocate is supported.
+ * If opened for direct I/O, transfers that are not aligned to
+ * DIRECT_IO_ALIGNMENT are carried out on the whole blocks they overlap. */
+class PositionalFile : public File {
+public:
+    explicit PositionalFile(
+        const std::filesystem::path& path, bool direct = false
+    );
+    ~PositionalFile() override;
+
+    PositionalFile(const PositionalFile&) = delete;
+    PositionalFile& operator=(const PositionalFile&) = delete;
+
+    void read(std::streamoff offset, std::byte* dst, std::size_t size)
+        override;
+    void write(std::streamoff offset, const std::byte* src, std::size_t size)
+        override;
+    std::size_t writev(
+        std::streamoff offset, span<const std::byte*> srcs, std::size_t size
+    ) override;
+
+    std::streamoff size() override;
+    void flush() override {}
+
+    void resize(std::streamoff size) override;
+
+    /* Without fallocate (MINISQL_FALLOCATE) these do nothing: the file then
+     * grows a page at a time through resize, and discarded bytes keep their
+     * storage. */
+    void reserve(std::streamoff size) override;
+    void discard(std::streamoff offset, std::size_t size) override;
+
+    std::byte* map(std::streamoff length) override;
+
+    int descriptor() const override { return fd_; }
+    bool direct() const noexcept override { return direct_; }
+
+private:
+    struct Mapping { std::byte* addr; std::size_t length; };
+
+    int fd_;
+    bool direct_ {false};
+    std::vector<Mapping> mappings_;
+
+    std::size_t read_some(
+        std::streamoff offset, std::byte* dst, std::size_t size
+    );
+    void write_all(
+        std::streamoff offset, const std::byte* src, std::size_t size
+    );
+    void read_unaligned(
+        std::streamoff offset, std::byte* dst, std::size_t size
+    );
+    void write_unaligned(
+        std::streamoff offset, const std::byte* src, std::size_t size
+    );
+
+    static std::streamoff align_up(std::streamoff offset) {
+        return (offset + DIRECT_IO_ALIGNMENT - 1) / DIRECT_IO_ALIGNMENT *
+            DIRECT_IO_ALIGNMENT;
+    }
+
+    // Minimum length of a new mapping.
+    static constexpr std::size_t MIN_MAP_LENGTH_ = 1 << 20;
+};
+
+} // namespace minisql
+
+#endif // MINISQL_POSIX
+
+#endif // MINISQL_POSITIONAL_FILE_HPP
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "frame_manager/disk_manager/stream_file.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <vector>
+
+namespace minisql {
+
+/* Open the file with given path, creating it first if it does not exist.
+ * Throws an std::ios_base::failure if the file cannot be opened. */
+StreamFile::StreamFile(const std::filesystem::path& path) : file_{owned_} {
+    if (!std::filesystem::exists(path)) {
+        owned_.open(path, std::ios::out);
+        owned_.close();
+    }
+    owned_.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!owned_) throw std::ios_base::failure(
+        "Failed to open database: " + path.string()
+    );
+}
+
+// Read size bytes starting from offset into dst.
+void StreamFile::read(std::streamoff offset, std::byte* dst, std::size_t size)
+{
+    file_.seekg(offset);
+    file_.read(reinterpret_cast<char*>(dst), size);
+}
+
+// Write size bytes from src starting at offset.
+void StreamFile::write(
+    std::streamoff offset, const std::byte* src, std::size_t size
+) {
+    file_.seekp(offset);
+    file_.write(reinterpret_cast<const char*>(src), size);
+}
+
+// Return the size of the file in bytes.
+std::streamoff StreamFile::size() {
+    file_.seekg(0, std::ios::end);
+    return file_.tellg();
+}
+
+/* Grow the file to size bytes by appending zeros.
+ * Does nothing if the file is already at least size bytes. */
+void StreamFile::resize(std::streamoff size) {
+    const std::streamoff current = this->size();
+    if (size <= current) return;
+    std::vector<char> zeros(size - current);
+    file_.seekp(current);
+    file_.write(zeros.data(), zeros.size());
+}
+
+} // namespace minisql
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef MINISQL_STREAM_FILE_HPP
+#define MINISQL_STREAM_FILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+
+#include "frame_manager/disk_manager/file.hpp"
+
+namespace minisql {
+
+/* Stream File
+ * A File over an std::fstream, either borrowed or opened and owned.
+ * Every transfer seeks the shared stream first, so it must only be used from
+ * one thread at a time. */
+class StreamFile : public File {
+public:
+    explicit StreamFile(std::fstream& file) : file_{file} {}
+    explicit StreamFile(const std::filesystem::path& path);
+
+    StreamFile(const StreamFile&) = delete;
+    StreamFile& operator=(const StreamFile&) = delete;
+
+    void read(std::streamoff offset, std::byte* dst, std::size_t size)
+        override;
+    void write(std::streamoff offset, const std::byte* src, std::size_t size)
+        override;
+
+    std::streamoff size() override;
+    void flush() override { file_.flush(); }
+
+    void resize(std::streamoff size) override;
+
+private:
+    std::fstream owned_;
+    std::fstream& file_;
+};
+
+} // namespace minisql
+
+#endif // MINISQL_STREAM_FILE_HPP
\ No newline at end of file
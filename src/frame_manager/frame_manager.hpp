@@ -3,53 +3,121 @@
 
 #include <cstddef>
 #include <fstream>
+#include <ios>
+#include <memory>
+#include <utility>
+#include <vector>
 
+#include "frame_manager/cache/buffer_pool.hpp"
 #include "frame_manager/cache/cache.hpp"
 #include "frame_manager/cache/frame_view.hpp"
+#include "frame_manager/cache/scan_ring.hpp"
 #include "frame_manager/disk_manager/disk_manager.hpp"
+#include "frame_manager/disk_manager/file.hpp"
 #include "frame_manager/disk_manager/page_id_t.hpp"
-#include "frame_manager/free_list/free_list.hpp"
+#include "frame_manager/free_map/free_map.hpp"
+#include "minisql/cache_stats.hpp"
+#include "minisql/options.hpp"
+#include "span.hpp"
 
 namespace minisql {
 
 /* Frame Manager
- * Acts as an in-memory buffer pool for database pages. Handles LRU eviction,
- * dirty‑page flushing, and page allocation/reuse. */
+ * Acts as an in-memory buffer pool for database pages. Handles eviction,
+ * dirty‑page flushing, and page allocation/reuse.
+ * Pages can be allocated near a given page, or as an extent of contiguous
+ * pages whose pid's are pinned as needed, see FreeMap.
+ * If pool is given then pages are held in that (possibly shared) BufferPool
+ * instead of one of its own set up from the cache arguments. A nonzero
+ * dirty_ratio gives that pool a background writer. */
 class FrameManager {
 public:
+    FrameManager(
+        File& file, std::streamoff base_offset, std::size_t page_size,
+        page_id_t page_count, std::size_t cache_capacity,
+        page_id_t first_free_map_block = nullpid, bool mapped = false,
+        bool async_io = false,
+        page_id_t extent_pages = DiskManager::DEFAULT_EXTENT_PAGES,
+        bool compress = false, std::size_t max_cache_capacity = 0,
+        CachePolicy cache_policy = CachePolicy::CLOCK, bool huge_pages = false,
+        double dirty_ratio = 0, std::shared_ptr<BufferPool> pool = nullptr
+    ) : disk_{
+            file, base_offset, page_size, page_count, mapped, async_io,
+            extent_pages, compress
+        },
+        cache_{
+            disk_, pool ? std::move(pool) : std::make_shared<BufferPool>(
+                page_size, cache_capacity, max_cache_capacity, cache_policy,
+                huge_pages, dirty_ratio
+            )
+        },
+        free_map_{cache_, disk_, first_free_map_block} {}
     FrameManager(
         std::fstream& file, std::streamoff base_offset,
         std::size_t page_size, page_id_t page_count,
-        std::size_t cache_capacity, page_id_t first_free_list_block = nullpid
+        std::size_t cache_capacity, page_id_t first_free_map_block = nullpid
     ) : disk_{file, base_offset, page_size, page_count},
         cache_{disk_, cache_capacity},
-        free_list_{cache_, first_free_list_block} {}
+        free_map_{cache_, disk_, first_free_map_block} {}
     ~FrameManager() = default;
 
     FrameManager(const FrameManager&) = delete;
     FrameManager& operator=(const FrameManager&) = delete;
 
-    FrameView pin(page_id_t pid) { return cache_.pin(pid); }
+    FrameView pin(page_id_t pid, ScanRing* ring = nullptr) {
+        return cache_.pin(pid, ring);
+    }
+    void prefetch(span<page_id_t> pids, ScanRing* ring = nullptr) {
+        cache_.prefetch(pids, ring);
+    }
+
+    FrameView pin_new(page_id_t pid) { return cache_.pin_new(pid); }
+    FrameView allocate(page_id_t near = nullpid) {
+        return cache_.pin_new(free_map_.allocate(near));
+    }
+    page_id_t allocate_extent(page_id_t n) {
+        return free_map_.allocate_extent(n);
+    }
+    void deallocate(page_id_t pid) {
+        cache_.unkeep(pid);
+        free_map_.free(pid);
+    }
+    void deallocate(span<page_id_t> pids) {
+        cache_.drop(pids);
+        free_map_.free(pids);
+    }
 
-    FrameView allocate() {
-        if (!free_list_.empty()) return cache_.pin(free_list_.pop_back());
-        page_id_t pid = disk_.page_count();
-        disk_.extend();
-        return cache_.pin(pid);
+    std::size_t resize_cache(std::size_t capacity) {
+        return cache_.resize(capacity);
     }
-    void deallocate(page_id_t pid) { free_list_.push_back(pid); }
 
-    void flush_all() { cache_.flush_all(); }
+    WriteStats flush_all() { return cache_.flush_all(); }
+    void discard() { cache_.discard(); }
+
+    std::vector<page_id_t> hot_pages() const { return cache_.hot_pages(); }
 
     page_id_t page_count() const noexcept { return disk_.page_count(); }
-    page_id_t first_free_list_block() const noexcept {
-        return free_list_.first_free_list_block();
+    std::size_t page_size() const noexcept { return disk_.page_size(); }
+    std::size_t cache_capacity() const noexcept { return cache_.capacity(); }
+    bool async_io() const noexcept { return disk_.async(); }
+    const CacheStats& cache_stats() const noexcept { return cache_.stats(); }
+    const PrefetchStats& prefetch_stats() const noexcept {
+        return cache_.prefetch_stats();
+    }
+    CompressionStats compression_stats() const {
+        return disk_.compression_stats();
+    }
+    page_id_t free_page_count() const noexcept {
+        return free_map_.free_count();
+    }
+    page_id_t first_free_map_block() const noexcept {
+        return free_map_.first_block();
     }
 
 private:
     DiskManager disk_;
     Cache cache_;
-    FreeList free_list_;
+    FreeMap free_map_;
 };
 
 } // namespace minisql
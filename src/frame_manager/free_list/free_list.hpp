@@ -7,7 +7,13 @@
 namespace minisql {
 
 /* Free List
- * A stack of free page_id_t's. */
+ * A stack of free page_id_t's, held in a chain of FreeListBlocks linked from
+ * the top of the stack down, so that pushing and popping only ever touch the
+ * first block. Freed pages make up the blocks themselves: a page pushed when
+ * the first block is full becomes the new first block, and is popped once it
+ * is empty.
+ * Free pages are now tracked by a FreeMap, so a FreeList is only kept to be
+ * emptied into one when a file in the original format is opened. */
 class FreeList {
 public:
     FreeList(Cache& cache, page_id_t first_free_list_block)
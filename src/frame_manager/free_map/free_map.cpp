@@ -0,0 +1,188 @@
+#include "frame_manager/free_map/free_map.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/free_list/free_list.hpp"
+#include "frame_manager/free_map/free_map_block.hpp"
+#include "headers.hpp"
+#include "span.hpp"
+
+namespace minisql {
+
+/* Load the chain of blocks starting at first_block, counting the free pages
+ * under each, or empty a FreeList starting there into a new chain. */
+FreeMap::FreeMap(Cache& cache, DiskManager& disk, page_id_t first_block)
+    : cache_{cache}, disk_{disk},
+      block_pages_{static_cast<page_id_t>(
+          FreeMapBlock::capacity(disk.page_size())
+      )} {
+    if (first_block == nullpid) return;
+    const Magic magic =
+        cache_.pin(first_block).view<Magic>(BaseHeader::MAGIC_OFFSET);
+    if (magic == Magic::FREE_LIST_BLOCK) {
+        FreeList free_list{cache_, first_block};
+        while (!free_list.empty()) free(free_list.pop_back());
+        return;
+    }
+    for (page_id_t pid = first_block; pid != nullpid;) {
+        FreeMapBlock block{cache_.pin(pid)};
+        blocks_.push_back(pid);
+        free_counts_.push_back(static_cast<page_id_t>(block.count()));
+        free_count_ += free_counts_.back();
+        pid = block.next_block();
+    }
+}
+
+/* Return the pid of a page to use, preferring one near the page at near if
+ * given.
+ * A page after near is preferred, then extending the File if its end is near,
+ * then a page before near. Failing that the lowest free page is used, so that
+ * the File stays compact, and only failing that is the File extended. */
+page_id_t FreeMap::allocate(page_id_t near) {
+    page_id_t pid = nullpid;
+    if (near != nullpid) {
+        pid = find(near + 1, near + 1 + NEAR_PAGES);
+        if (pid == nullpid && near + NEAR_PAGES >= disk_.page_count())
+            return extend();
+        if (pid == nullpid)
+            pid = find_last(near < NEAR_PAGES ? 0 : near - NEAR_PAGES, near);
+    }
+    if (pid == nullpid && free_count_) pid = find(0, covered());
+    if (pid == nullpid) return extend();
+    take(pid);
+    return pid;
+}
+
+/* Return the pid of the first of n contiguous pages to use.
+ * The lowest run of n free pages is used, or else a run of free pages at the
+ * end of the File is completed by extending it, or else the File is extended
+ * by n pages. */
+page_id_t FreeMap::allocate_extent(page_id_t n) {
+    page_id_t start = nullpid, run = 0;
+    if (free_count_) {
+        for (
+            page_id_t pid = find(0, covered()); pid != nullpid;
+            pid = find(pid + 1, covered())
+        ) {
+            if (run && pid == start + run) run++;
+            else {
+                start = pid;
+                run = 1;
+            }
+            if (run == n) break;
+        }
+    }
+    if (run < n && (!run || start + run != disk_.page_count())) {
+        start = disk_.page_count();
+        run = 0;
+    }
+    for (page_id_t pid = start; pid < start + run; pid++) take(pid);
+    for (page_id_t i = run; i < n; i++) extend();
+    return start;
+}
+
+/* Mark the page at pid as free, first adding blocks to cover it if needed.
+ * Freeing a free page does nothing. */
+void FreeMap::free(page_id_t pid) {
+    while (pid >= covered()) add_block();
+    const std::size_t b = pid / block_pages_;
+    FreeMapBlock block{cache_.pin(blocks_[b])};
+    if (block.test(pid % block_pages_)) return;
+    block.set(pid % block_pages_);
+    free_counts_[b]++;
+    free_count_++;
+}
+
+/* Mark the pages at pids as free, in order of pid so that each block is only
+ * pinned once. */
+void FreeMap::free(span<page_id_t> pids) {
+    if (pids.empty()) return;
+    std::vector<page_id_t> sorted(pids.begin(), pids.end());
+    std::sort(sorted.begin(), sorted.end());
+    while (sorted.back() >= covered()) add_block();
+    for (std::size_t i = 0; i < sorted.size();) {
+        const std::size_t b = sorted[i] / block_pages_;
+        FreeMapBlock block{cache_.pin(blocks_[b])};
+        for (; i < sorted.size() && sorted[i] / block_pages_ == b; i++) {
+            if (block.test(sorted[i] % block_pages_)) continue;
+            block.set(sorted[i] % block_pages_);
+            free_counts_[b]++;
+            free_count_++;
+        }
+    }
+}
+
+bool FreeMap::is_free(page_id_t pid) {
+    if (pid >= covered() || !free_counts_[pid / block_pages_]) return false;
+    const FreeMapBlock block{cache_.pin(blocks_[pid / block_pages_])};
+    return block.test(pid % block_pages_);
+}
+
+// Return the first free page in [begin, end), or nullpid if there is none.
+page_id_t FreeMap::find(page_id_t begin, page_id_t end) {
+    end = std::min(end, covered());
+    while (begin < end) {
+        const std::size_t b = begin / block_pages_;
+        const page_id_t base = static_cast<page_id_t>(b) * block_pages_;
+        const page_id_t block_end = std::min(end, base + block_pages_);
+        if (free_counts_[b]) {
+            const FreeMapBlock block{cache_.pin(blocks_[b])};
+            const std::size_t i = block.find(begin - base, block_end - base);
+            if (i != block_end - base) return base + static_cast<page_id_t>(i);
+        }
+        begin = block_end;
+    }
+    return nullpid;
+}
+
+// Return the last free page in [begin, end), or nullpid if there is none.
+page_id_t FreeMap::find_last(page_id_t begin, page_id_t end) {
+    end = std::min(end, covered());
+    while (begin < end) {
+        const std::size_t b = (end - 1) / block_pages_;
+        const page_id_t base = static_cast<page_id_t>(b) * block_pages_;
+        const page_id_t block_begin = std::max(begin, base);
+        if (free_counts_[b]) {
+            const FreeMapBlock block{cache_.pin(blocks_[b])};
+            const std::size_t i =
+                block.find_last(block_begin - base, end - base);
+            if (i != end - base) return base + static_cast<page_id_t>(i);
+        }
+        end = block_begin;
+    }
+    return nullpid;
+}
+
+// Mark the free page at pid as in use.
+void FreeMap::take(page_id_t pid) {
+    const std::size_t b = pid / block_pages_;
+    FreeMapBlock block{cache_.pin(blocks_[b])};
+    block.reset(pid % block_pages_);
+    free_counts_[b]--;
+    free_count_--;
+}
+
+// Extend the File by a page and return its pid.
+page_id_t FreeMap::extend() {
+    const page_id_t pid = disk_.page_count();
+    disk_.extend();
+    return pid;
+}
+
+/* Add a block to the end of the chain, in a page at the end of the File,
+ * covering the next block_pages_ pages. */
+void FreeMap::add_block() {
+    const page_id_t pid = extend();
+    const FreeMapBlock block{cache_.pin(pid), true};
+    if (!blocks_.empty()) {
+        FreeMapBlock last{cache_.pin(blocks_.back())};
+        last.set_next_block(pid);
+    }
+    blocks_.push_back(pid);
+    free_counts_.push_back(0);
+}
+
+} // namespace minisql
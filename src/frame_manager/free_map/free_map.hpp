@@ -0,0 +1,66 @@
+#ifndef MINISQL_FREE_MAP_HPP
+#define MINISQL_FREE_MAP_HPP
+
+#include <vector>
+
+#include "frame_manager/cache/cache.hpp"
+#include "frame_manager/disk_manager/disk_manager.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "span.hpp"
+
+namespace minisql {
+
+/* Free Map
+ * Tracks the free pages of the File in a bitmap held in a chain of
+ * FreeMapBlocks, the i'th of which covers the block_pages pages from
+ * i * block_pages. The number of free pages under each block is kept in
+ * memory, so that blocks with none are skipped without being pinned.
+ * A page can be allocated near another, so that pages read one after the other
+ * (such as sibling leaves of a BPlusTree) sit next to each other in the File,
+ * and runs of contiguous pages can be allocated as an extent. The File is
+ * only extended when no suitable free page is found.
+ * Pages past those covered are in use, so blocks are only added, at the end of
+ * the File, once a page past them is freed. The chain may instead start with a
+ * FreeListBlock, from a File written before the Free Map, in which case the
+ * FreeList is emptied into the map. */
+class FreeMap {
+public:
+    // How far either side of a page a page allocated near it may be.
+    static constexpr page_id_t NEAR_PAGES = 64;
+
+    FreeMap(Cache& cache, DiskManager& disk, page_id_t first_block);
+
+    page_id_t allocate(page_id_t near = nullpid);
+    page_id_t allocate_extent(page_id_t n);
+    void free(page_id_t pid);
+    void free(span<page_id_t> pids);
+
+    bool is_free(page_id_t pid);
+
+    page_id_t free_count() const noexcept { return free_count_; }
+    page_id_t first_block() const noexcept {
+        return blocks_.empty() ? nullpid : blocks_.front();
+    }
+
+private:
+    Cache& cache_;
+    DiskManager& disk_;
+    const page_id_t block_pages_;
+    std::vector<page_id_t> blocks_;
+    std::vector<page_id_t> free_counts_;
+    page_id_t free_count_ {0};
+
+    page_id_t covered() const noexcept {
+        return static_cast<page_id_t>(blocks_.size()) * block_pages_;
+    }
+
+    page_id_t find(page_id_t begin, page_id_t end);
+    page_id_t find_last(page_id_t begin, page_id_t end);
+    void take(page_id_t pid);
+    page_id_t extend();
+    void add_block();
+};
+
+} // namespace minisql
+
+#endif // MINISQL_FREE_MAP_HPP
@@ -0,0 +1,102 @@
+#ifndef MINISQL_FREE_MAP_BLOCK_HPP
+#define MINISQL_FREE_MAP_BLOCK_HPP
+
+#include <bitset>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+#include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/cache/frame_view.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "headers.hpp"
+
+namespace minisql {
+
+/* Free Map Block
+ * Acts as an interface over a page, consisting of a FreeMapBlockHeader
+ * followed by a bitmap in which bit i is set if the i'th page the block
+ * covers is free. A new block has every bit clear. */
+class FreeMapBlock {
+public:
+    FreeMapBlock(FrameView&& fv, bool new_ = false) : fv_{std::move(fv)} {
+        if (new_) {
+            std::memset(fv_.mutable_data(), 0, fv_.page_size());
+            fv_.write<Magic>(
+                FreeMapBlockHeader::MAGIC_OFFSET, Magic::FREE_MAP_BLOCK
+            );
+            set_next_block(nullpid);
+        }
+        else {
+            Magic magic = fv_.view<Magic>(FreeMapBlockHeader::MAGIC_OFFSET);
+            if (magic != Magic::FREE_MAP_BLOCK) throw MagicException(magic);
+        }
+    }
+
+    // Return the number of pages covered by a block of a page of page_size.
+    static std::size_t capacity(std::size_t page_size) {
+        return (page_size - FreeMapBlockHeader::SIZE) * 8;
+    }
+
+    page_id_t next_block() const {
+        return fv_.view<page_id_t>(FreeMapBlockHeader::NEXT_BLOCK_OFFSET);
+    }
+    void set_next_block(page_id_t pid) {
+        fv_.write<page_id_t>(FreeMapBlockHeader::NEXT_BLOCK_OFFSET, pid);
+    }
+
+    bool test(std::size_t i) const {
+        return (bitmap()[i / 8] >> (i % 8) & std::byte{1}) != std::byte{0};
+    }
+    void set(std::size_t i) {
+        mutable_bitmap()[i / 8] |= std::byte{1} << (i % 8);
+    }
+    void reset(std::size_t i) {
+        mutable_bitmap()[i / 8] &= ~(std::byte{1} << (i % 8));
+    }
+
+    // Return the number of bits set.
+    std::size_t count() const {
+        std::size_t count = 0;
+        const std::byte* bits = bitmap();
+        for (std::size_t i = 0; i < capacity(fv_.page_size()) / 8; i++)
+            count += std::bitset<8>(std::to_integer<unsigned>(bits[i])).count();
+        return count;
+    }
+
+    /* Return the first bit set in [begin, end), or end if there is none.
+     * Bytes with no bits set are skipped whole. */
+    std::size_t find(std::size_t begin, std::size_t end) const {
+        const std::byte* bits = bitmap();
+        for (std::size_t i = begin; i < end;) {
+            if (i % 8 == 0 && bits[i / 8] == std::byte{0}) i += 8;
+            else if (test(i)) return i;
+            else i++;
+        }
+        return end;
+    }
+    // Return the last bit set in [begin, end), or end if there is none.
+    std::size_t find_last(std::size_t begin, std::size_t end) const {
+        const std::byte* bits = bitmap();
+        for (std::size_t i = end; i > begin;) {
+            if (i % 8 == 0 && i - 8 >= begin && bits[i / 8 - 1] == std::byte{0})
+                i -= 8;
+            else if (test(--i)) return i;
+        }
+        return end;
+    }
+
+private:
+    FrameView fv_;
+
+    const std::byte* bitmap() const {
+        return fv_.data() + FreeMapBlockHeader::SIZE;
+    }
+    std::byte* mutable_bitmap() {
+        return fv_.mutable_data() + FreeMapBlockHeader::SIZE;
+    }
+};
+
+} // namespace minisql
+
+#endif // MINISQL_FREE_MAP_BLOCK_HPP
@@ -0,0 +1,103 @@
+#include "frame_manager/warm_list/warm_list.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/cache/frame_view.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/frame_manager.hpp"
+#include "headers.hpp"
+#include "minisql/cache_stats.hpp"
+#include "span.hpp"
+
+namespace minisql::warm_list {
+
+/* Write pids to a chain of newly allocated pages and return the page_id_t of
+ * the first, or nullpid if pids is empty. */
+page_id_t save(FrameManager& fm, const std::vector<page_id_t>& pids) {
+    using count_t = WarmListBlockHeader::count_t;
+    const std::size_t per_block =
+        (fm.page_size() - WarmListBlockHeader::SIZE) / sizeof(page_id_t);
+
+    // Fill the blocks from the last, so that each knows the next
+    page_id_t next_block = nullpid;
+    for (std::size_t end = pids.size(); end;) {
+        const std::size_t begin = (end - 1) / per_block * per_block;
+        FrameView fv = fm.allocate();
+        fv.write<Magic>(
+            WarmListBlockHeader::MAGIC_OFFSET, Magic::WARM_LIST_BLOCK
+        );
+        fv.write<count_t>(
+            WarmListBlockHeader::COUNT_OFFSET,
+            static_cast<count_t>(end - begin)
+        );
+        fv.write<page_id_t>(WarmListBlockHeader::NEXT_BLOCK_OFFSET, next_block);
+        for (std::size_t i = begin; i < end; i++) {
+            fv.write<page_id_t>(
+                WarmListBlockHeader::SIZE + (i - begin) * sizeof(page_id_t),
+                pids[i]
+            );
+        }
+        next_block = fv.pid();
+        end = begin;
+    }
+    return next_block;
+}
+
+/* Read the page_id_t's stored in the chain starting at first_block, returning
+ * each page of the chain to the free map once read. Throws a MagicException
+ * if a page of the chain is not a warm list block. */
+std::vector<page_id_t> load(FrameManager& fm, page_id_t first_block) {
+    using count_t = WarmListBlockHeader::count_t;
+    std::vector<page_id_t> pids;
+    for (page_id_t pid = first_block; pid != nullpid;) {
+        const page_id_t block = pid;
+        {
+            FrameView fv = fm.pin(block);
+            const Magic magic =
+                fv.view<Magic>(WarmListBlockHeader::MAGIC_OFFSET);
+            if (magic != Magic::WARM_LIST_BLOCK) throw MagicException(magic);
+            const count_t count =
+                fv.view<count_t>(WarmListBlockHeader::COUNT_OFFSET);
+            for (count_t i = 0; i < count; i++) {
+                pids.push_back(fv.view<page_id_t>(
+                    WarmListBlockHeader::SIZE + i * sizeof(page_id_t)
+                ));
+            }
+            pid = fv.view<page_id_t>(WarmListBlockHeader::NEXT_BLOCK_OFFSET);
+            fv.mark_deleted();
+        }
+        fm.deallocate(block);
+    }
+    return pids;
+}
+
+/* Read the pages at pids into the cache, keeping to the first of them if they
+ * do not all fit. They are read in page_id_t order, in batches of
+ * WARM_UP_BATCH through the prefetch path, so the last batch may still be in
+ * flight on return. */
+WarmUpStats warm_up(FrameManager& fm, std::vector<page_id_t> pids) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint64_t prefetched = fm.prefetch_stats().pages;
+
+    pids.resize(std::min(pids.size(), fm.cache_capacity()));
+    std::sort(pids.begin(), pids.end());
+    for (std::size_t i = 0; i < pids.size(); i += WARM_UP_BATCH) {
+        fm.prefetch(span<page_id_t>{
+            pids.data() + i, std::min(WARM_UP_BATCH, pids.size() - i)
+        });
+    }
+
+    WarmUpStats stats;
+    stats.pages = fm.prefetch_stats().pages - prefetched;
+    stats.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start
+    );
+    return stats;
+}
+
+} // namespace minisql::warm_list
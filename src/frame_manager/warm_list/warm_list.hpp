@@ -0,0 +1,32 @@
+#ifndef MINISQL_WARM_LIST_HPP
+#define MINISQL_WARM_LIST_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/frame_manager.hpp"
+#include "minisql/cache_stats.hpp"
+
+namespace minisql {
+
+/* Namespace for recording the pages held in the cache when a database is
+ * closed, so that they can be read back in when it is next opened instead of
+ * each being missed by the first queries.
+ * The page_id_t's are stored, those most worth keeping first, in a chain of
+ * pages each made up of a WarmListBlockHeader followed by as many page_id_t's
+ * as fit. */
+namespace warm_list {
+
+// Number of pages read in by each prefetch of warm_up.
+inline constexpr std::size_t WARM_UP_BATCH = 64;
+
+page_id_t save(FrameManager& fm, const std::vector<page_id_t>& pids);
+std::vector<page_id_t> load(FrameManager& fm, page_id_t first_block);
+WarmUpStats warm_up(FrameManager& fm, std::vector<page_id_t> pids);
+
+} // namespace warm_list
+
+} // namespace minisql
+
+#endif // MINISQL_WARM_LIST_HPP
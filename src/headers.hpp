@@ -11,10 +11,16 @@ namespace minisql {
 /* Magic
  * Indicates the type and structure of a page. */
 enum class Magic : std::uint8_t {
-    DATABASE = 0,
+    LEGACY_DATABASE = 0,
+    // Set apart from the page types, which are numbered from 1.
+    DATABASE = 0xdb,
     FREE_LIST_BLOCK = 1,
     INTERNAL_NODE = 2,
     LEAF_NODE = 3,
+    COMPRESSED_PAGE = 4,
+    WARM_LIST_BLOCK = 5,
+    FREE_MAP_BLOCK = 6,
+    RECLAIM_LIST_BLOCK = 7,
 };
 
 /* BaseHeader Structure:
@@ -26,16 +32,79 @@ struct BaseHeader {
 
 /* DatabaseHeader Structure
  * - BaseHeader
+ * - std::uint16_t format_version
  * - page_id_t page_count
- * - page_id_t first_free_list_block
- * - page_id_t master_root */
+ * - page_id_t first_free_map_block
+ * - page_id_t master_root
+ * - std::uint32_t page_size
+ * - std::uint32_t base_offset
+ * - page_id_t first_warm_list_block
+ * - page_id_t first_reclaim_list_block
+ * RESERVED_SIZE bytes are set aside for the header, so that fields can be
+ * added without moving the pages. The reserved bytes not yet in use are
+ * written as all ones, so that a page_id_t field added later reads as nullpid
+ * in a file written before it. */
 struct DatabaseHeader : public BaseHeader {
+    using format_version_t = std::uint16_t;
+    using page_size_t = std::uint32_t;
+    using base_offset_t = std::uint32_t;
+
+    static constexpr std::size_t FORMAT_VERSION_OFFSET = BaseHeader::SIZE;
+    static constexpr std::size_t PAGE_COUNT_OFFSET =
+        FORMAT_VERSION_OFFSET + sizeof(format_version_t);
+    static constexpr std::size_t FIRST_FREE_MAP_BLOCK_OFFSET =
+        PAGE_COUNT_OFFSET + sizeof(page_id_t);
+    static constexpr std::size_t MASTER_ROOT_OFFSET =
+        FIRST_FREE_MAP_BLOCK_OFFSET + sizeof(page_id_t);
+    static constexpr std::size_t PAGE_SIZE_OFFSET =
+        MASTER_ROOT_OFFSET + sizeof(page_id_t);
+    static constexpr std::size_t BASE_OFFSET_OFFSET =
+        PAGE_SIZE_OFFSET + sizeof(page_size_t);
+    static constexpr std::size_t FIRST_WARM_LIST_BLOCK_OFFSET =
+        BASE_OFFSET_OFFSET + sizeof(base_offset_t);
+    static constexpr std::size_t FIRST_RECLAIM_LIST_BLOCK_OFFSET =
+        FIRST_WARM_LIST_BLOCK_OFFSET + sizeof(page_id_t);
+    static constexpr std::size_t SIZE =
+        FIRST_RECLAIM_LIST_BLOCK_OFFSET + sizeof(page_id_t);
+    static constexpr std::size_t RESERVED_SIZE = 64;
+    static_assert(SIZE <= RESERVED_SIZE);
+
+    // The version of the format written, the only one that can be read.
+    static constexpr format_version_t FORMAT_VERSION = 1;
+
+    // Range of supported page sizes (each a power of two).
+    static constexpr std::size_t MIN_PAGE_SIZE = 1024;
+    static constexpr std::size_t MAX_PAGE_SIZE = 65536;
+};
+
+/* LegacyDatabaseHeader Structure
+ * - BaseHeader
+ * - page_id_t page_count
+ * - page_id_t first_free_list_block
+ * - page_id_t master_root
+ * The header of a file written by the first version of Mini-SQL, before the
+ * format was versioned, followed straight away by PAGE_SIZE byte pages. */
+struct LegacyDatabaseHeader : public BaseHeader {
     static constexpr std::size_t PAGE_COUNT_OFFSET = BaseHeader::SIZE;
     static constexpr std::size_t FIRST_FREE_LIST_BLOCK_OFFSET =
         PAGE_COUNT_OFFSET + sizeof(page_id_t);
     static constexpr std::size_t MASTER_ROOT_OFFSET =
         FIRST_FREE_LIST_BLOCK_OFFSET + sizeof(page_id_t);
     static constexpr std::size_t SIZE = MASTER_ROOT_OFFSET + sizeof(page_id_t);
+
+    static constexpr std::size_t PAGE_SIZE = 4096;
+};
+
+/* CompressedPageHeader Structure:
+ * - BaseHeader
+ * - std::uint16_t compressed_size
+ * Followed by compressed_size bytes of the lz-compressed page. */
+struct CompressedPageHeader : public BaseHeader {
+    using compressed_size_t = std::uint16_t;
+
+    static constexpr std::size_t COMPRESSED_SIZE_OFFSET = BaseHeader::SIZE;
+    static constexpr std::size_t SIZE =
+        COMPRESSED_SIZE_OFFSET + sizeof(compressed_size_t);
 };
 
 /* FreeListBlockHeader Structure:
@@ -51,6 +120,46 @@ struct FreeListBlockHeader : public BaseHeader {
     static constexpr std::size_t SIZE = NEXT_BLOCK_OFFSET + sizeof(page_id_t);
 };
 
+/* FreeMapBlockHeader Structure:
+ * - BaseHeader
+ * - page_id_t next_block
+ * Followed by a bitmap of the pages the block covers. */
+struct FreeMapBlockHeader : public BaseHeader {
+    static constexpr std::size_t NEXT_BLOCK_OFFSET = BaseHeader::SIZE;
+    static constexpr std::size_t SIZE = NEXT_BLOCK_OFFSET + sizeof(page_id_t);
+};
+
+/* WarmListBlockHeader Structure:
+ * - BaseHeader
+ * - std::uint16_t count
+ * - page_id_t next_block
+ * Followed by count page_id_t's. */
+struct WarmListBlockHeader : public BaseHeader {
+    using count_t = std::uint16_t;
+
+    static constexpr std::size_t COUNT_OFFSET = BaseHeader::SIZE;
+    static constexpr std::size_t NEXT_BLOCK_OFFSET =
+        COUNT_OFFSET + sizeof(count_t);
+    static constexpr std::size_t SIZE = NEXT_BLOCK_OFFSET + sizeof(page_id_t);
+};
+
+/* ReclaimListBlockHeader Structure:
+ * - BaseHeader
+ * - std::uint16_t count
+ * - page_id_t next_block
+ * Followed by count entries, each a page_id_t and a std::uint8_t height. */
+struct ReclaimListBlockHeader : public BaseHeader {
+    using count_t = std::uint16_t;
+    using height_t = std::uint8_t;
+
+    static constexpr std::size_t COUNT_OFFSET = BaseHeader::SIZE;
+    static constexpr std::size_t NEXT_BLOCK_OFFSET =
+        COUNT_OFFSET + sizeof(count_t);
+    static constexpr std::size_t SIZE = NEXT_BLOCK_OFFSET + sizeof(page_id_t);
+    static constexpr std::size_t ENTRY_SIZE =
+        sizeof(page_id_t) + sizeof(height_t);
+};
+
 /* NodeHeader Structure:
  * - BaseHeader
  * - std::uint8_t key_size
@@ -7,6 +7,7 @@
 #include <variant>
 #include <vector>
 
+#include "catalog/cache_priority.hpp"
 #include "field/type.hpp"
 
 namespace minisql::parser {
@@ -27,18 +28,20 @@ struct Modification {
     std::variant<Value, std::string> value;
 };
 
-struct CreateAST {
+struct SelectAST {
     std::string table;
     std::vector<std::string> columns;
-    std::vector<FieldType> types;
-    std::vector<std::size_t> sizes;
-    std::optional<std::string> primary {std::nullopt};
+    std::vector<Condition> conditions;
 };
 
-struct SelectAST {
+struct CreateAST {
     std::string table;
     std::vector<std::string> columns;
-    std::vector<Condition> conditions;
+    std::vector<FieldType> types;
+    std::vector<std::size_t> sizes;
+    std::optional<std::string> primary {std::nullopt};
+    CachePriority cache_priority {CachePriority::NORMAL};
+    std::optional<SelectAST> select {std::nullopt};
 };
 
 struct InsertAST {
@@ -62,8 +65,10 @@ struct DropAST {
     std::string table;
 };
 
+struct VacuumAST {};
+
 using AST = std::variant<
-    CreateAST, SelectAST, InsertAST, UpdateAST, DeleteAST, DropAST
+    CreateAST, SelectAST, InsertAST, UpdateAST, DeleteAST, DropAST, VacuumAST
 >;
 
 } // namespace minisql::parser
@@ -7,6 +7,7 @@
 #include <utility>
 #include <vector>
 
+#include "catalog/cache_priority.hpp"
 #include "exceptions/query_exceptions.hpp"
 #include "field/type.hpp"
 #include "parser/ast.hpp"
@@ -33,6 +34,7 @@ public:
             case TokenType::UPDATE: return parse_update();
             case TokenType::DELETE: return parse_delete();
             case TokenType::DROP: return parse_drop();
+            case TokenType::VACUUM: return parse_vacuum();
             default: raise_exception();
         }
         unreachable();
@@ -79,6 +81,8 @@ private:
 
     Condition parse_condition();
     Modification parse_modification();
+    CachePriority parse_cache_option();
+    CachePriority parse_with_clause();
     
     CreateAST parse_create();
     SelectAST parse_select();
@@ -86,6 +90,7 @@ private:
     UpdateAST parse_update();
     DeleteAST parse_delete();
     DropAST parse_drop();
+    VacuumAST parse_vacuum();
 
     void raise_exception() { throw SyntaxException(peek().text); }
 };
@@ -137,6 +142,7 @@ void Parser::tokenise(std::string_view sql) {
             else if (text == "UPDATE") type = TokenType::UPDATE;
             else if (text == "DELETE") type = TokenType::DELETE;
             else if (text == "DROP") type = TokenType::DROP;
+            else if (text == "VACUUM") type = TokenType::VACUUM;
             else if (text == "TABLE") type = TokenType::TABLE;
             else if (text == "INT") type = TokenType::INT;
             else if (text == "REAL") type = TokenType::REAL;
@@ -149,6 +155,8 @@ void Parser::tokenise(std::string_view sql) {
             else if (text == "SET") type = TokenType::SET;
             else if (text == "WHERE") type = TokenType::WHERE;
             else if (text == "AND") type = TokenType::AND;
+            else if (text == "WITH") type = TokenType::WITH;
+            else if (text == "AS") type = TokenType::AS;
             else type = TokenType::IDENTIFIER;
             tokens_.push_back({type, std::string(text)});
         }
@@ -256,13 +264,53 @@ Modification Parser::parse_modification() {
     return modification;
 }
 
-// Return a CreateAST built from tokens.
+/* Return the CachePriority given by a cache option of a WITH clause, of the
+ * form cache = keep or cache = normal. */
+CachePriority Parser::parse_cache_option() {
+
+    if (peek().type != TokenType::IDENTIFIER || peek().text != "cache")
+        raise_exception();
+    advance();
+    if (expect(TokenType::OPERATOR).text != "=") raise_exception();
+
+    CachePriority priority;
+    if (peek().text == "keep") priority = CachePriority::KEEP;
+    else if (peek().text == "normal") priority = CachePriority::NORMAL;
+    else raise_exception();
+    expect(TokenType::IDENTIFIER);
+    return priority;
+}
+
+/* Return the CachePriority given by the options of a WITH clause, of the form
+ * (cache = keep), following WITH. */
+CachePriority Parser::parse_with_clause() {
+
+    expect(TokenType::LPAREN);
+    const CachePriority priority = parse_cache_option();
+    expect(TokenType::RPAREN);
+    return priority;
+}
+
+/* Return a CreateAST built from tokens, either declaring columns or taking
+ * them from a SELECT statement following AS. A WITH clause follows the
+ * columns, or comes before AS as the SELECT statement ends the statement. */
 CreateAST Parser::parse_create() {
 
     expect(TokenType::CREATE);
     expect(TokenType::TABLE);
     CreateAST ast = {parse_identifier()};
 
+    if (match(TokenType::WITH)) {
+        ast.cache_priority = parse_with_clause();
+        expect(TokenType::AS);
+        ast.select = parse_select();
+        return ast;
+    }
+    if (match(TokenType::AS)) {
+        ast.select = parse_select();
+        return ast;
+    }
+
     expect(TokenType::LPAREN);
     ast.columns.push_back(parse_identifier());
     FieldType type = parse_type();
@@ -309,7 +357,9 @@ CreateAST Parser::parse_create() {
         }
     }
     expect(TokenType::RPAREN);
-    
+
+    if (match(TokenType::WITH)) ast.cache_priority = parse_with_clause();
+
     expect(TokenType::SEMICOLON);
     return ast;
 }
@@ -425,6 +475,15 @@ DropAST Parser::parse_drop() {
     return ast;
 }
 
+// Return a VacuumAST build from tokens.
+VacuumAST Parser::parse_vacuum() {
+
+    expect(TokenType::VACUUM);
+
+    expect(TokenType::SEMICOLON);
+    return {};
+}
+
 } // namespace
 
 AST parse(std::string_view sql) {
@@ -8,9 +8,9 @@ namespace minisql::parser {
 
 enum class TokenType : std::uint8_t {
     LPAREN, RPAREN, STAR, COMMA, SEMICOLON,
-    CREATE, SELECT, INSERT, UPDATE, DELETE, DROP,
+    CREATE, SELECT, INSERT, UPDATE, DELETE, DROP, VACUUM,
     TABLE, INT, REAL, TEXT, PRIMARY, KEY,
-    FROM, INTO, VALUES, SET, WHERE, AND,
+    FROM, INTO, VALUES, SET, WHERE, AND, WITH, AS,
     IDENTIFIER, NUMBER, STRING, OPERATOR
 };
 
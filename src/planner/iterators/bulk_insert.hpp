@@ -0,0 +1,59 @@
+#ifndef MINISQL_PLANNER_BULK_INSERT_HPP
+#define MINISQL_PLANNER_BULK_INSERT_HPP
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "cursor.hpp"
+#include "planner/iterators/iterator.hpp"
+#include "row/row_view.hpp"
+#include "span.hpp"
+
+namespace minisql::planner {
+
+/* Inserts all Rows from an Iterator into a B+ Tree at once, building the tree
+ * bottom-up if it is empty and the Rows have distinct keys. Otherwise the
+ * Rows are inserted one at a time in the order given, as by Insert. */
+class BulkInsert : public Iterator {
+public:
+    // Fewest Rows worth inserting this way rather than with an Insert.
+    static constexpr std::size_t MIN_ROWS = 64;
+
+    BulkInsert(
+        std::unique_ptr<Iterator> child, std::unique_ptr<Cursor> cursor,
+        double fill_factor
+    ) : child_{std::move(child)}, cursor_{std::move(cursor)},
+        fill_factor_{fill_factor} {}
+
+    bool next() override {
+        if (inserted_) return false;
+        std::vector<RowView> rows;
+        while (child_->next()) rows.push_back(child_->current());
+        std::vector<span<std::byte>> slots;
+        slots.reserve(rows.size());
+        for (const RowView& rv : rows) slots.push_back(rv.data());
+        if (cursor_->load(std::move(slots), fill_factor_))
+            count_ = rows.size();
+        else for (const RowView& rv : rows) {
+            cursor_->seek(rv.primary());
+            cursor_->insert(rv);
+            count_++;
+        }
+        inserted_ = true;
+        return true;
+    }
+
+    RowView current() override { return RowView{{}, nullptr}; }
+
+private:
+    std::unique_ptr<Iterator> child_;
+    std::unique_ptr<Cursor> cursor_;
+    double fill_factor_;
+    bool inserted_ {false};
+};
+
+} // namespace minisql::planner
+
+#endif // MINISQL_PLANNER_BULK_INSERT_HPP
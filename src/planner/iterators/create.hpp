@@ -5,25 +5,46 @@
 #include <string>
 #include <utility>
 
+#include "catalog/cache_priority.hpp"
 #include "catalog/catalog.hpp"
+#include "cursor.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "planner/iterators/bulk_insert.hpp"
 #include "planner/iterators/iterator.hpp"
+#include "planner/iterators/number.hpp"
 #include "row/row_view.hpp"
 #include "row/schema.hpp"
 
 namespace minisql::planner {
 
-// Creates a new Table.
+/* Creates a new Table with the given CachePriority, filled with the Rows from
+ * rows if given (see BulkInsert), numbered by their rowid. */
 class Create : public Iterator {
 public:
     Create(
         Catalog& catalog, const std::string& table,
-        std::unique_ptr<Schema> schema
-    ) : catalog_{catalog}, table_{table}, schema_{std::move(schema)} {}
+        std::unique_ptr<Schema> schema,
+        CachePriority cache_priority = CachePriority::NORMAL,
+        std::unique_ptr<Iterator> rows = nullptr
+    ) : catalog_{catalog}, table_{table}, schema_{std::move(schema)},
+        cache_priority_{cache_priority}, rows_{std::move(rows)} {}
 
     bool next() override {
         if (created_) return false;
-        catalog_.add_table(table_, std::move(schema_));
+        catalog_.add_table(
+            table_, std::move(schema_), nullpid, 0, cache_priority_
+        );
         created_ = true;
+        if (!rows_) return true;
+
+        Table* table = catalog_.find_table(table_);
+        BulkInsert insert{
+            std::make_unique<Number>(std::move(rows_), table),
+            std::make_unique<Cursor>(table->bp_tree.get(), *(table->schema)),
+            catalog_.fill_factor()
+        };
+        while (insert.next());
+        count_ = insert.count();
         return true;
     }
 
@@ -33,6 +54,8 @@ private:
     Catalog& catalog_;
     std::string table_;
     std::unique_ptr<Schema> schema_;
+    CachePriority cache_priority_;
+    std::unique_ptr<Iterator> rows_;
     bool created_ {false};
 };
 
@@ -0,0 +1,48 @@
+#ifndef MINISQL_PLANNER_NUMBER_HPP
+#define MINISQL_PLANNER_NUMBER_HPP
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "catalog/table.hpp"
+#include "minisql/field.hpp"
+#include "minisql/row.hpp"
+#include "planner/iterators/iterator.hpp"
+#include "row/row_view.hpp"
+#include "row/schema.hpp"
+
+namespace minisql::planner {
+
+/* Outputs Rows from an Iterator as Rows of a Table with a default primary
+ * column (its last), numbered from the Table's next rowid. */
+class Number : public Iterator {
+public:
+    Number(std::unique_ptr<Iterator> child, Table* table)
+        : child_{std::move(child)}, table_{table},
+          schema_{std::make_shared<Schema>(*(table->schema))} {}
+
+    bool next() override {
+        if (!child_->next()) return false;
+        rowid_ = table_->next_rowid++;
+        count_++;
+        return true;
+    }
+
+    RowView current() override {
+        const Row row = child_->current().deserialise();
+        std::vector<Field> fields{row.begin(), row.end()};
+        fields.push_back(static_cast<int>(rowid_));
+        return serialise(Row{std::move(fields), schema_});
+    }
+
+private:
+    std::unique_ptr<Iterator> child_;
+    Table* table_;
+    std::shared_ptr<Schema> schema_;
+    rowid_t rowid_ {0};
+};
+
+} // namespace minisql::planner
+
+#endif // MINISQL_PLANNER_NUMBER_HPP
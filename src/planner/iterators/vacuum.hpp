@@ -0,0 +1,36 @@
+#ifndef MINISQL_PLANNER_VACUUM_HPP
+#define MINISQL_PLANNER_VACUUM_HPP
+
+#include <cstddef>
+
+#include "catalog/catalog.hpp"
+#include "planner/iterators/iterator.hpp"
+#include "row/row_view.hpp"
+
+namespace minisql::planner {
+
+// Frees all pages of dropped Tables still to be reclaimed.
+class Vacuum : public Iterator {
+public:
+    // Number of pages freed at a time.
+    static constexpr std::size_t BUDGET = 4096;
+
+    explicit Vacuum(Catalog& catalog) : catalog_{catalog} {}
+
+    bool next() override {
+        if (vacuumed_) return false;
+        while (catalog_.reclaim(BUDGET));
+        vacuumed_ = true;
+        return true;
+    }
+
+    RowView current() override { return RowView{{}, nullptr}; }
+
+private:
+    Catalog& catalog_;
+    bool vacuumed_ {false};
+};
+
+} // namespace minisql::planner
+
+#endif // MINISQL_PLANNER_VACUUM_HPP
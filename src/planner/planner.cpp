@@ -1,5 +1,6 @@
 #include "planner/planner.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -10,6 +11,7 @@
 #include "catalog/table.hpp"
 #include "cursor.hpp"
 #include "planner/compiler.hpp"
+#include "planner/iterators/bulk_insert.hpp"
 #include "planner/iterators/create.hpp"
 #include "planner/iterators/drop.hpp"
 #include "planner/iterators/erase.hpp"
@@ -19,6 +21,7 @@
 #include "planner/iterators/project.hpp"
 #include "planner/iterators/table_scan.hpp"
 #include "planner/iterators/update.hpp"
+#include "planner/iterators/vacuum.hpp"
 #include "planner/iterators/values.hpp"
 #include "row/schema.hpp"
 #include "validator/constants.hpp"
@@ -31,14 +34,18 @@ namespace {
 /* Return a TableScan or IndexScan over the Rows held within the B+ Tree that
  * cursor corresponds to.
  * Iterates through conditions and applies them to the primary index directly
- * via an IndexScan or copies them into filter_conditions. */
+ * via an IndexScan or copies them into filter_conditions.
+ * The cursor of a TableScan is marked as making a bulk scan, so that a large
+ * table is read through a ring of Frames rather than the whole cache. */
 Plan make_scan(
     std::unique_ptr<Cursor> cursor, const Schema& schema, 
     const std::vector<validator::Condition>& conditions,
     std::vector<validator::Condition>& filter_conditions
 ) {
-    if (conditions.empty())
+    if (conditions.empty()) {
+        cursor->set_bulk();
         return std::make_unique<TableScan>(std::move(cursor), schema);
+    }
 
     Plan scan;
     std::optional<validator::Condition> lower_bound;
@@ -110,9 +117,10 @@ Plan make_scan(
 
     if (!scan) {
         if (!lower_bound) {
-            if (!upper_bound) scan = std::make_unique<TableScan>(
-                std::move(cursor), schema
-            );
+            if (!upper_bound) {
+                cursor->set_bulk();
+                scan = std::make_unique<TableScan>(std::move(cursor), schema);
+            }
             else scan = std::make_unique<IndexScan>(
                 std::move(cursor), schema, std::nullopt, false,
                 std::move(upper_bound->value),
@@ -147,11 +155,16 @@ Plan make_scan(
     return scan;
 }
 
-// Return a Create iterator corresponding to a CreateQuery.
+Plan plan(const validator::SelectQuery& query, const Catalog& catalog);
+
+/* Return a Create iterator corresponding to a CreateQuery, given an iterator
+ * tree for its SelectQuery if it has one. */
 Plan plan(const validator::CreateQuery& query, Catalog& catalog) {
     return std::make_unique<Create>(
         catalog, query.table,
-        Schema::create(query.columns, query.types, query.sizes, query.primary)
+        Schema::create(query.columns, query.types, query.sizes, query.primary),
+        query.cache_priority,
+        query.select ? plan(*query.select, catalog) : nullptr
     );
 }
 
@@ -185,16 +198,18 @@ Plan plan(const validator::SelectQuery& query, const Catalog& catalog) {
 }
 
 /* Return an iterator tree corresponding to an InsertQuery.
- * Chains together a Values and an Insert. */
-Plan plan(const validator::InsertQuery& query, const Catalog& catalog) {
+ * Chains together a Values and an Insert, or a BulkInsert if there are enough
+ * values. The values are moved out of query rather than copied. */
+Plan plan(validator::InsertQuery query, const Catalog& catalog) {
 
     const Table* table = catalog.find_table(query.table);
     auto cursor = std::make_unique<Cursor>(
         table->bp_tree.get(), *(table->schema)
     );
 
+    const std::size_t rows = query.values.size();
     Plan plan = std::make_unique<Values>(
-        query.values,
+        std::move(query.values),
         std::make_shared<Schema>(
             query.columns[0] != validator::defaults::ALL_COLUMNS ?
             table->schema->project(query.columns) :
@@ -202,6 +217,10 @@ Plan plan(const validator::InsertQuery& query, const Catalog& catalog) {
         )
     );
 
+    if (rows >= BulkInsert::MIN_ROWS)
+        return std::make_unique<BulkInsert>(
+            std::move(plan), std::move(cursor), catalog.fill_factor()
+        );
     return std::make_unique<Insert>(std::move(plan), std::move(cursor));
 }
 
@@ -212,7 +231,7 @@ Plan plan(const validator::UpdateQuery& query, const Catalog& catalog) {
 
     const Table* table = catalog.find_table(query.table);
     auto cursor = std::make_unique<Cursor>(
-        table->bp_tree.get(), *(table->schema)
+        table->bp_tree.get(), *(table->schema), true
     );
 
     std::vector<validator::Condition> filter_conditions;
@@ -259,6 +278,11 @@ Plan plan(const validator::DropQuery& query, Catalog& catalog) {
     return std::make_unique<Drop>(catalog, query.table);
 }
 
+// Return a Vacuum iterator corresponding to a VacuumQuery.
+Plan plan(const validator::VacuumQuery&, Catalog& catalog) {
+    return std::make_unique<Vacuum>(catalog);
+}
+
 // Visitor struct for dispatching validated queries to correct planner.
 struct Planner {
     Catalog& catalog;
@@ -272,6 +296,9 @@ struct Planner {
     Plan operator()(const validator::InsertQuery& query) const {
         return plan(query, catalog);
     }
+    Plan operator()(validator::InsertQuery&& query) const {
+        return plan(std::move(query), catalog);
+    }
     Plan operator()(const validator::UpdateQuery& query) const {
         return plan(query, catalog);
     }
@@ -281,6 +308,9 @@ struct Planner {
     Plan operator()(const validator::DropQuery& query) const {
         return plan(query, catalog);
     }
+    Plan operator()(const validator::VacuumQuery& query) const {
+        return plan(query, catalog);
+    }
 };
 
 } // namespace
@@ -290,4 +320,10 @@ Plan plan(const validator::Query& query, Catalog& catalog) {
     return std::visit(Planner{catalog}, query);
 }
 
+/* Return a plan according to the given Query, taking the values of an
+ * InsertQuery rather than copying them. Any other Query is left as it was. */
+Plan plan(validator::Query&& query, Catalog& catalog) {
+    return std::visit(Planner{catalog}, std::move(query));
+}
+
 } // namespace minisql::planner
\ No newline at end of file
@@ -11,6 +11,7 @@ namespace minisql::planner {
 
 using Plan = std::unique_ptr<Iterator>;
 Plan plan(const validator::Query&, Catalog&);
+Plan plan(validator::Query&&, Catalog&);
 
 } // namespace minisql::planner
 
@@ -0,0 +1,31 @@
+#ifndef MINISQL_PLATFORM_HPP
+#define MINISQL_PLATFORM_HPP
+
+// Defined on platforms providing the POSIX file API (pread, pwrite, etc).
+#if defined(__unix__) || defined(__APPLE__)
+    #define MINISQL_POSIX 1
+#endif
+
+// Defined on platforms providing direct I/O through O_DIRECT.
+#if defined(__linux__)
+    #define MINISQL_DIRECT_IO 1
+#endif
+
+// Defined on platforms providing fallocate with FALLOC_FL_KEEP_SIZE.
+#if defined(__linux__)
+    #define MINISQL_FALLOCATE 1
+#endif
+
+// Defined on platforms providing io_uring (used through raw syscalls).
+#if defined(__linux__) && defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+        #define MINISQL_IO_URING 1
+    #endif
+#endif
+
+// Defined on platforms providing transparent huge pages through madvise.
+#if defined(__linux__)
+    #define MINISQL_HUGE_PAGES 1
+#endif
+
+#endif // MINISQL_PLATFORM_HPP
\ No newline at end of file
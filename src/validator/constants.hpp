@@ -24,7 +24,8 @@ inline const std::string ALL_COLUMNS = "*";
 
 namespace limits {
 
-inline const std::size_t MAX_TABLE_WIDTH = 512;
+// A row may take up at most 1 / MIN_ROWS_PER_PAGE of a page.
+inline const std::size_t MIN_ROWS_PER_PAGE = 8;
 
 } // namespace limits
 
@@ -2,10 +2,12 @@
 #define MINISQL_VALIDATOR_QUERY_HPP
 
 #include <cstddef>
+#include <optional>
 #include <string>
 #include <variant>
 #include <vector>
 
+#include "catalog/cache_priority.hpp"
 #include "field/type.hpp"
 #include "minisql/field.hpp"
 
@@ -25,18 +27,20 @@ struct Modification {
     std::variant<Field, std::string> value;
 };
 
-struct CreateQuery {
+struct SelectQuery {
     std::string table;
     std::vector<std::string> columns;
-    std::vector<FieldType> types;
-    std::vector<std::size_t> sizes;
-    std::string primary;
+    std::vector<Condition> conditions;
 };
 
-struct SelectQuery {
+struct CreateQuery {
     std::string table;
     std::vector<std::string> columns;
-    std::vector<Condition> conditions;
+    std::vector<FieldType> types;
+    std::vector<std::size_t> sizes;
+    std::string primary;
+    CachePriority cache_priority {CachePriority::NORMAL};
+    std::optional<SelectQuery> select {std::nullopt};
 };
 
 struct InsertQuery {
@@ -60,8 +64,11 @@ struct DropQuery {
     std::string table;
 };
 
+struct VacuumQuery {};
+
 using Query = std::variant<
-    CreateQuery, SelectQuery, InsertQuery, UpdateQuery, DeleteQuery, DropQuery
+    CreateQuery, SelectQuery, InsertQuery, UpdateQuery, DeleteQuery, DropQuery,
+    VacuumQuery
 >;
 
 } // namespace minisql::validator
@@ -13,6 +13,7 @@
 #include "exceptions/query_exceptions.hpp"
 #include "field/type.hpp"
 #include "minisql/field.hpp"
+#include "minisql/varchar.hpp"
 #include "parser/ast.hpp"
 #include "row/schema.hpp"
 #include "unreachable.hpp"
@@ -43,6 +44,35 @@ Field validate(const parser::Value& value, const Schema::Column* column) {
     unreachable();
 }
 
+/* Return a Field of the required type and size obtained from field, moving
+ * it if it already is.
+ * Throws a ColumnTypeException if not possible. */
+Field validate(Field field, const Schema::Column* column) {
+    switch (column->type) {
+        case FieldType::INT:
+            if (std::holds_alternative<Varchar>(field))
+                throw ColumnTypeException(column->name, "INT/REAL");
+            if (std::holds_alternative<double>(field))
+                return static_cast<int>(std::get<double>(field));
+            return field;
+        case FieldType::REAL:
+            if (std::holds_alternative<Varchar>(field))
+                throw ColumnTypeException(column->name, "INT/REAL");
+            if (std::holds_alternative<int>(field))
+                return static_cast<double>(std::get<int>(field));
+            return field;
+        case FieldType::TEXT:
+            if (!std::holds_alternative<Varchar>(field))
+                throw ColumnTypeException(column->name, "TEXT");
+            if (std::get<Varchar>(field).size() == column->size) return field;
+            return Varchar{
+                static_cast<const char*>(std::get<Varchar>(field).data()),
+                column->size
+            };
+    }
+    unreachable();
+}
+
 /* Return a validated Condition from the given parser::Condition while:
  * - Verifying column's existence.
  * - Verifying value's type. */
@@ -120,14 +150,18 @@ Modification validate(
     };
 }
 
+SelectQuery validate(const parser::SelectAST& ast, const Catalog& catalog);
+
 /* Return a validated CreateQuery from the given parser::CreateAST while:
  * - Asserting table name is not too long.
  * - Verifying table doesn't exist.
+ * - Validating the SELECT statement if given, and taking the columns it
+ * selects (without their primary key) as the columns.
  * - Asserting no duplicate column names.
  * - Asserting no column uses the reserved default primary name.
  * - Verifying the primary column exists if it is provided, and inserting a
  * default primary column otherwise.
- * - Asserting the total row width is not too long. */
+ * - Asserting the total row width is not too long for the page size. */
 CreateQuery validate(const parser::CreateAST& ast, const Catalog& catalog) {
 
     if (ast.table.size() > master_table::MAX_TABLE_NAME_SIZE)
@@ -137,17 +171,32 @@ CreateQuery validate(const parser::CreateAST& ast, const Catalog& catalog) {
     if (table) throw TableExistenceException(ast.table, true);
     CreateQuery query = {ast.table};
 
+    if (ast.select) {
+        query.select = validate(*ast.select, catalog);
+        const Schema& schema = *(catalog.find_table(ast.select->table)->schema);
+        if (query.select->columns[0] == defaults::ALL_COLUMNS)
+            for (int i = 0; i < schema.size(); i++)
+                query.columns.push_back(schema[i]->name);
+        else query.columns = query.select->columns;
+        for (const std::string& column : query.columns) {
+            query.types.push_back(schema[column]->type);
+            query.sizes.push_back(schema[column]->size);
+        }
+    }
+    else {
+        query.columns = ast.columns;
+        query.types = ast.types;
+        query.sizes = ast.sizes;
+    }
+    query.cache_priority = ast.cache_priority;
+
     std::unordered_set<std::string> seen_columns;
-    for (const std::string& column : ast.columns) {
+    for (const std::string& column : query.columns) {
         if (!seen_columns.insert(column).second)
             throw ColumnExistenceException(column, true);
         if (column == defaults::primary::NAME)
             throw ReservedColumnException(column);
     }
-
-    query.columns = ast.columns;
-    query.types = ast.types;
-    query.sizes = ast.sizes;
     
     if (ast.primary) {
         if (seen_columns.insert(*ast.primary).second)
@@ -161,13 +210,15 @@ CreateQuery validate(const parser::CreateAST& ast, const Catalog& catalog) {
         query.primary = defaults::primary::NAME;
     }
 
+    const std::size_t max_width =
+        catalog.page_size() / limits::MIN_ROWS_PER_PAGE;
     if (
         std::size_t width = std::accumulate(
             query.sizes.begin(), query.sizes.end(), 0
         );
-        width > limits::MAX_TABLE_WIDTH
+        width > max_width
     )
-        throw TableWidthException(ast.table, width, limits::MAX_TABLE_WIDTH);
+        throw TableWidthException(ast.table, width, max_width);
 
     return query;
 }
@@ -355,6 +406,9 @@ struct Validator {
     Query operator()(const parser::DropAST& ast) const {
         return validate(ast, catalog);
     }
+    Query operator()(const parser::VacuumAST&) const {
+        return VacuumQuery{};
+    }
 };
 
 } // namespace
@@ -364,4 +418,38 @@ Query validate(const parser::AST& ast, Catalog& catalog, bool master_enabled) {
     return std::visit(Validator{catalog, master_enabled}, ast);
 }
 
+/* Return a validated InsertQuery of rows of Fields for every column of the
+ * given table (as imported in bulk) while:
+ * - Verifying table's existence.
+ * - Asserting table is not the master table.
+ * - Asserting all values are present.
+ * - Validating all values.
+ * - Appending default values if the primary column is the default. */
+InsertQuery validate(
+    const std::string& table_name, std::vector<std::vector<Field>> rows,
+    Catalog& catalog
+) {
+    Table* table = catalog.find_table(table_name);
+    if (!table || table_name == master_table::NAME)
+        throw TableExistenceException(table_name, false);
+    InsertQuery query = {table_name, {defaults::ALL_COLUMNS}};
+
+    const Schema& schema = *(table->schema);
+    bool use_rowid = schema.primary().name == defaults::primary::NAME;
+    std::size_t required_columns =
+        use_rowid ? schema.size() - 1 : schema.size();
+    for (std::vector<Field>& row : rows) {
+        if (row.size() != required_columns)
+            throw ValueCountException(row.size() < required_columns);
+        for (std::size_t i = 0; i < row.size(); i++)
+            row[i] = validate(std::move(row[i]), schema[i]);
+    }
+    if (use_rowid)
+        for (std::vector<Field>& row : rows)
+            row.push_back(static_cast<int>(table->next_rowid++));
+
+    query.values = std::move(rows);
+    return query;
+}
+
 } // namespace minisql::validator
\ No newline at end of file
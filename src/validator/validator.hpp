@@ -1,13 +1,20 @@
 #ifndef MINISQL_VALIDATOR_HPP
 #define MINISQL_VALIDATOR_HPP
 
+#include <string>
+#include <vector>
+
 #include "catalog/catalog.hpp"
+#include "minisql/field.hpp"
 #include "parser/ast.hpp"
 #include "validator/query.hpp"
 
 namespace minisql::validator {
 
 Query validate(const parser::AST&, Catalog&, bool);
+InsertQuery validate(
+    const std::string&, std::vector<std::vector<Field>>, Catalog&
+);
 
 } // namespace minisql::validator
 
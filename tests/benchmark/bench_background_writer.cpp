@@ -0,0 +1,117 @@
+/* Measures the latency of pinning pages at random from a database several
+ * times the size of the cache while a share of them are modified, with and
+ * without a background writer. Without one, most misses first have to write
+ * a dirty victim back; with one, victims have usually been written already.
+ * Reports the mean and 99th percentile latency of pins that missed.
+ * Usage: bench_background_writer [page_count] [accesses] [write_share] */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "frame_manager/cache/buffer_pool.hpp"
+#include "frame_manager/cache/cache.hpp"
+#include "frame_manager/cache/frame_view.hpp"
+#include "frame_manager/disk_manager/disk_manager.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/disk_manager/positional_file.hpp"
+#include "minisql/options.hpp"
+#include "platform.hpp"
+
+using namespace minisql;
+
+#ifdef MINISQL_POSIX
+
+namespace {
+
+constexpr std::size_t PAGE_SIZE = 4096;
+constexpr std::size_t CACHE_CAPACITY = 2000;
+constexpr double DIRTY_RATIO = 0.1;
+
+/* Pin accesses random pages of disk through a Cache with a background writer
+ * if dirty_ratio is nonzero, modifying write_share of them. Prints the
+ * latency of the pins that missed. */
+void run(
+    const char* name, DiskManager& disk, std::size_t accesses,
+    double write_share, double dirty_ratio
+) {
+    auto pool = std::make_shared<BufferPool>(
+        PAGE_SIZE, CACHE_CAPACITY, 0, CachePolicy::CLOCK, false, dirty_ratio
+    );
+    Cache cache{disk, pool};
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<page_id_t> page(0, disk.page_count() - 1);
+    std::bernoulli_distribution modify(write_share);
+
+    std::vector<double> latencies;
+    std::size_t checksum = 0;
+    for (std::size_t i = 0; i < accesses; i++) {
+        const page_id_t pid = page(rng);
+        const bool write = modify(rng);
+        const std::uint64_t misses = cache.stats().misses;
+        const auto start = std::chrono::steady_clock::now();
+        FrameView view = cache.pin(pid);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        if (cache.stats().misses != misses) {
+            latencies.push_back(
+                std::chrono::duration<double, std::micro>(elapsed).count()
+            );
+        }
+        if (write) view.write<page_id_t>(0, view.view<page_id_t>(0) + 1);
+        else checksum += view.view<page_id_t>(0);
+    }
+    cache.flush_all();
+    if (checksum == static_cast<std::size_t>(-1)) std::cout << checksum;
+
+    std::sort(latencies.begin(), latencies.end());
+    double total = 0;
+    for (double latency : latencies) total += latency;
+    std::printf(
+        "%-10s %zu misses   mean %6.2f us   p99 %7.2f us\n", name,
+        latencies.size(), total / latencies.size(),
+        latencies[latencies.size() * 99 / 100]
+    );
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const page_id_t page_count = argc > 1 ? std::atoi(argv[1]) : 20000;
+    const std::size_t accesses = argc > 2 ? std::atoi(argv[2]) : 500000;
+    const double write_share = argc > 3 ? std::atof(argv[3]) : 0.5;
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "bench_background_writer.db";
+    std::filesystem::remove(path);
+    {
+        PositionalFile file{path};
+        DiskManager disk{file, 0, PAGE_SIZE, 0};
+        for (page_id_t pid = 0; pid < page_count; pid++) disk.extend();
+
+        std::printf(
+            "%u pages, cache of %zu frames, %zu accesses, %.0f%% writes\n",
+            page_count, CACHE_CAPACITY, accesses, write_share * 100
+        );
+        run("no writer", disk, accesses, write_share, 0);
+        run("writer", disk, accesses, write_share, DIRTY_RATIO);
+    }
+    std::filesystem::remove(path);
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "bench_background_writer requires POSIX positional I/O"
+        << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,118 @@
+/* Measures loading rows shaped as in 400_insert_small_seq into an empty table
+ * one INSERT statement per row, as that test does, against loading the same
+ * rows with a single Connection::import (which builds the table's tree
+ * bottom-up) and copying them with CREATE TABLE ... AS SELECT. Reports the
+ * time taken by each, closing the database included (but for CREATE TABLE
+ * ... AS SELECT, which is timed alone), the pages each pinned and the size of
+ * the file written.
+ * Usage: bench_bulk_load [rows] */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "minisql/cache_stats.hpp"
+#include "minisql/connection.hpp"
+#include "minisql/field.hpp"
+#include "minisql/varchar.hpp"
+
+using namespace minisql;
+
+namespace {
+
+const char* CREATE_SQL =
+    "CREATE TABLE int_real_text (int INT, real REAL, text TEXT(16), "
+    "flag_50_percent INT, flag_25_percent INT);";
+
+struct Result {
+    double ms;
+    unsigned long long pins;
+    std::uintmax_t size;
+};
+
+/* Return the time taken by load on a new database, the pages it pinned and the
+ * size of the file. */
+template <typename Load>
+Result measure(const std::filesystem::path& path, Load load) {
+    std::filesystem::remove(path);
+    unsigned long long pins = 0;
+    const auto start = std::chrono::steady_clock::now();
+    {
+        Connection connection{path};
+        connection.exec(CREATE_SQL);
+        const CacheStats before = connection.cache_stats();
+        load(connection);
+        const CacheStats after = connection.cache_stats();
+        pins = after.hits + after.misses - before.hits - before.misses;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const Result result{
+        std::chrono::duration<double, std::milli>(elapsed).count(), pins,
+        std::filesystem::file_size(path)
+    };
+    std::filesystem::remove(path);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int rows = argc > 1 ? std::atoi(argv[1]) : 40000;
+
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<double> real(0, 1);
+    std::vector<std::string> inserts;
+    std::vector<std::vector<Field>> fields;
+    for (int i = 0; i < rows; i++) {
+        const double r = real(rng);
+        const int flag_50 = rng() % 2;
+        const int flag_25 = rng() % 4 == 0;
+        const std::string text = std::to_string(i);
+        inserts.push_back(
+            "INSERT INTO int_real_text VALUES (" + std::to_string(i) + "," +
+            std::to_string(r) + ",\"" + text + "\"," +
+            std::to_string(flag_50) + "," + std::to_string(flag_25) + ");"
+        );
+        fields.push_back({
+            i, r, Varchar{text.c_str(), text.size()}, flag_50, flag_25
+        });
+    }
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "bench_bulk_load.db";
+    const Result insert = measure(path, [&](Connection& connection) {
+        for (const std::string& sql : inserts) connection.exec(sql);
+    });
+    const Result import = measure(path, [&](Connection& connection) {
+        connection.import("int_real_text", fields);
+    });
+    double create_ms = 0;
+    const Result create = measure(path, [&](Connection& connection) {
+        connection.import("int_real_text", fields);
+        const auto start = std::chrono::steady_clock::now();
+        connection.exec("CREATE TABLE copy AS SELECT * FROM int_real_text;");
+        create_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start
+        ).count();
+    });
+
+    std::printf("%d rows\n", rows);
+    std::printf(
+        "INSERT per row  %9.1f ms, %8llu pages pinned, %8.1f KB\n", insert.ms,
+        insert.pins, insert.size / 1e3
+    );
+    std::printf(
+        "import          %9.1f ms, %8llu pages pinned, %8.1f KB\n", import.ms,
+        import.pins, import.size / 1e3
+    );
+    std::printf(
+        "CREATE AS       %9.1f ms, %8.1f KB more than import\n", create_ms,
+        (create.size - import.size) / 1e3
+    );
+    return 0;
+}
@@ -0,0 +1,115 @@
+/* Measures dropping a table several times the size of the cache, filled in
+ * random key order as in 413_drop_random, after reopening the database with
+ * the kernel's cache of the file dropped, as after a restart. Reports the time
+ * taken by the DROP TABLE, the statement after it (which frees some of the
+ * table's pages) and a VACUUM freeing the rest, the number of pages each
+ * pinned, and how many of those had to be read in on being pinned.
+ * Usage: bench_drop_table [rows] */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "minisql/cache_stats.hpp"
+#include "minisql/connection.hpp"
+#include "minisql/options.hpp"
+#include "platform.hpp"
+
+#ifdef MINISQL_POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace minisql;
+
+#ifdef MINISQL_POSIX
+
+namespace {
+
+constexpr std::size_t CACHE_CAPACITY = 1000;
+constexpr int BATCH_ROWS = 1000;
+
+// Evict the pages of the file at path from the kernel's cache.
+void drop_os_cache(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    ::fsync(fd);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int rows = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "bench_drop_table.db";
+    std::filesystem::remove(path);
+    {
+        Connection connection{path};
+        connection.exec(
+            "CREATE TABLE t (id INT, real REAL, text TEXT(16), "
+            "PRIMARY KEY(id));"
+        );
+        std::mt19937 rng{42};
+        std::uniform_int_distribution<int> id(0, 1 << 30);
+        for (int row = 0; row < rows; row += BATCH_ROWS) {
+            std::string sql = "INSERT INTO t VALUES ";
+            for (int i = 0; i < BATCH_ROWS; i++) {
+                const std::string key = std::to_string(id(rng));
+                sql += (i ? ", (" : "(") + key + ", " + key + ".5, \"text\")";
+            }
+            try {
+                connection.exec(sql + ";");
+            }
+            catch (const std::exception&) {} // A duplicate key
+        }
+    }
+    const auto size = std::filesystem::file_size(path);
+    drop_os_cache(path);
+
+    Options options;
+    options.cache_capacity = CACHE_CAPACITY;
+    Connection connection{path, options};
+    std::printf(
+        "%d rows, %.1f MB file, cache of %zu pages, %zu pages reclaimed per "
+        "statement\n", rows, size / 1e6, CACHE_CAPACITY, options.reclaim_pages
+    );
+    CacheStats last = connection.cache_stats();
+    auto run = [&](const char* label, const char* sql) {
+        const auto start = std::chrono::steady_clock::now();
+        connection.exec(sql);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const CacheStats stats = connection.cache_stats();
+        std::printf(
+            "%-16s %8.2f ms, %llu pages pinned (%llu misses)\n", label,
+            std::chrono::duration<double, std::milli>(elapsed).count(),
+            static_cast<unsigned long long>(
+                stats.hits + stats.misses - last.hits - last.misses
+            ),
+            static_cast<unsigned long long>(stats.misses - last.misses)
+        );
+        last = stats;
+    };
+    run("DROP TABLE", "DROP TABLE t;");
+    run("next statement", "CREATE TABLE u (id INT);");
+    run("VACUUM", "VACUUM;");
+    std::filesystem::remove(path);
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "bench_drop_table requires POSIX" << std::endl;
+    return 0;
+}
+
+#endif
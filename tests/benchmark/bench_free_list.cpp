@@ -0,0 +1,67 @@
+/* Measures the cost of page allocation after a large table has been dropped:
+ * every page of the table is freed onto the free list and then allocated again
+ * in turn. Reports the mean time per free and per allocation, the latter over
+ * successive slices of the allocations, to show whether it depends on how
+ * long the free list still is.
+ * Usage: bench_free_list [page_count] [slices] */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <ios>
+#include <vector>
+
+#include "frame_manager/cache/frame_view.hpp"
+#include "frame_manager/disk_manager/memory_file.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/frame_manager.hpp"
+
+using namespace minisql;
+
+namespace {
+
+constexpr std::size_t PAGE_SIZE = 4096;
+constexpr std::size_t CACHE_CAPACITY = 2000;
+
+// Return the mean nanoseconds taken per operation over n operations.
+double per_op(std::chrono::steady_clock::duration elapsed, std::size_t n) {
+    return std::chrono::duration<double, std::nano>(elapsed).count() / n;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const page_id_t page_count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const std::size_t slices = argc > 2 ? std::atoi(argv[2]) : 10;
+
+    MemoryFile file{static_cast<std::streamoff>(PAGE_SIZE * page_count)};
+    FrameManager fm{file, 0, PAGE_SIZE, 0, CACHE_CAPACITY};
+    std::vector<page_id_t> pids;
+    for (page_id_t i = 0; i < page_count; i++)
+        pids.push_back(fm.allocate().pid());
+
+    auto start = std::chrono::steady_clock::now();
+    for (page_id_t pid : pids) fm.deallocate(pid);
+    std::printf(
+        "%u pages, cache of %zu frames\nfree      %8.1f ns per page\n",
+        page_count, CACHE_CAPACITY,
+        per_op(std::chrono::steady_clock::now() - start, page_count)
+    );
+
+    const std::size_t slice = page_count / slices;
+    for (std::size_t i = 0; i < slices; i++) {
+        start = std::chrono::steady_clock::now();
+        for (std::size_t j = 0; j < slice; j++) fm.allocate();
+        std::printf(
+            "allocate  %8.1f ns per page (pages %zu-%zu)\n",
+            per_op(std::chrono::steady_clock::now() - start, slice),
+            i * slice, (i + 1) * slice - 1
+        );
+    }
+    if (fm.page_count() != page_count) {
+        std::printf("free list lost pages\n");
+        return 1;
+    }
+    return 0;
+}
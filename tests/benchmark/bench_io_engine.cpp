@@ -0,0 +1,115 @@
+/* Compares the synchronous page I/O path of the Cache against batched
+ * prefetching through io_uring, on a sequential scan and on random point
+ * lookups over a database-sized file.
+ * Usage: bench_io_engine [page_count] [batch_size] */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "frame_manager/cache/cache.hpp"
+#include "frame_manager/cache/frame_view.hpp"
+#include "frame_manager/disk_manager/disk_manager.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/disk_manager/positional_file.hpp"
+#include "platform.hpp"
+
+using namespace minisql;
+
+#ifdef MINISQL_POSIX
+
+namespace {
+
+constexpr std::size_t PAGE_SIZE = 4096;
+constexpr std::size_t CACHE_CAPACITY = 2000;
+
+/* Pin every page in pids in order, prefetching the next batch_size pages
+ * ahead of each batch if batch_size is non-zero.
+ * Returns the elapsed time in milliseconds. */
+double run(
+    DiskManager& disk, const std::vector<page_id_t>& pids,
+    std::size_t batch_size
+) {
+    Cache cache{disk, CACHE_CAPACITY};
+    std::size_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < pids.size(); i++) {
+        if (batch_size && i % batch_size == 0) {
+            std::vector<page_id_t> batch(
+                pids.begin() + i,
+                pids.begin() + std::min(i + batch_size, pids.size())
+            );
+            cache.prefetch(batch);
+        }
+        checksum += cache.pin(pids[i]).view<page_id_t>(0);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    if (checksum == static_cast<std::size_t>(-1)) std::cout << checksum;
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void report(const char* name, double sync_ms, double async_ms) {
+    std::printf(
+        "%-20s sync %9.2f ms   io_uring %9.2f ms   speedup %5.2fx\n",
+        name, sync_ms, async_ms, sync_ms / async_ms
+    );
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const page_id_t page_count = argc > 1 ?
+        static_cast<page_id_t>(std::strtoul(argv[1], nullptr, 10)) : 65536;
+    const std::size_t batch_size = argc > 2 ?
+        std::strtoul(argv[2], nullptr, 10) : 32;
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "minisql_bench_io_engine.db";
+    std::filesystem::remove(path);
+    {
+        PositionalFile file{path};
+        DiskManager sync_disk{file, 0, PAGE_SIZE, 0};
+        std::vector<std::byte> page(PAGE_SIZE);
+        for (page_id_t pid = 0; pid < page_count; pid++) {
+            sync_disk.extend();
+            page[0] = static_cast<std::byte>(pid);
+            sync_disk.write(pid, page.data());
+        }
+        DiskManager async_disk{file, 0, PAGE_SIZE, page_count, false, true};
+        if (!async_disk.async())
+            std::cout << "io_uring unavailable, comparing against the "
+                "synchronous fallback" << std::endl;
+
+        std::vector<page_id_t> sequential(page_count);
+        for (page_id_t pid = 0; pid < page_count; pid++) sequential[pid] = pid;
+        report(
+            "sequential scan", run(sync_disk, sequential, 0),
+            run(async_disk, sequential, batch_size)
+        );
+
+        std::vector<page_id_t> random(page_count);
+        std::mt19937 rng{42};
+        std::uniform_int_distribution<page_id_t> dist{0, page_count - 1};
+        for (page_id_t& pid : random) pid = dist(rng);
+        report(
+            "random lookups", run(sync_disk, random, 0),
+            run(async_disk, random, batch_size)
+        );
+    }
+    std::filesystem::remove(path);
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "bench_io_engine requires a POSIX platform" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,89 @@
+/* Measures how the leaves of a B+ Tree are laid out in a file with free pages:
+ * two trees are built, one after the other or side by side so that their
+ * pages interleave, the first is destroyed, and then a third is built, with
+ * its keys in order, over the pages it freed. Reports how many of the third
+ * tree's leaf-to-leaf steps move to the very next page, how many runs of
+ * adjacent pages a scan of its leaves reads (each a seek on a disk), and the
+ * mean distance between successive leaves.
+ * Usage: bench_leaf_layout [rows] */
+
+#include <climits>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <ios>
+#include <vector>
+
+#include "bplus_tree/bplus_tree.hpp"
+#include "bplus_tree/leaf_node.hpp"
+#include "byte_io.hpp"
+#include "frame_manager/disk_manager/memory_file.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/frame_manager.hpp"
+
+using namespace minisql;
+
+namespace {
+
+constexpr std::size_t PAGE_SIZE = 4096;
+constexpr std::size_t CACHE_CAPACITY = 2000;
+constexpr BPlusTree::slot_size_t SLOT_SIZE = 200;
+
+// Insert key into bp_tree, in a slot of SLOT_SIZE bytes.
+void insert(BPlusTree& bp_tree, int key) {
+    auto leaf = bp_tree.seek_leaf<int>(key);
+    const auto slot = BPlusTree::seek_slot<int>(leaf.get(), key);
+    std::vector<std::byte> bytes(SLOT_SIZE);
+    byte_io::write<int>(bytes, 0, key);
+    bp_tree.insert_into<int>(leaf.get(), slot, bytes);
+}
+
+/* Build the trees over rows rows each, the first two side by side if
+ * interleave is set, and print the layout of the last one's leaves. */
+void run(const char* name, int rows, bool interleave) {
+    MemoryFile file{static_cast<std::streamoff>(PAGE_SIZE) * rows};
+    FrameManager fm{file, 0, PAGE_SIZE, 0, CACHE_CAPACITY};
+    BPlusTree dropped{&fm, sizeof(int), SLOT_SIZE};
+    BPlusTree kept{&fm, sizeof(int), SLOT_SIZE};
+    for (int key = 0; key < rows; key++) {
+        insert(dropped, key);
+        if (interleave) insert(kept, key);
+    }
+    if (!interleave)
+        for (int key = 0; key < rows; key++) insert(kept, key);
+    dropped.destroy();
+
+    BPlusTree bp_tree{&fm, sizeof(int), SLOT_SIZE};
+    for (int key = 0; key < rows; key++) insert(bp_tree, key);
+
+    std::size_t steps = 0, adjacent = 0, runs = 1;
+    double distance = 0;
+    auto leaf = bp_tree.seek_leaf<int>(INT_MIN);
+    while (!leaf->is_rightmost()) {
+        const page_id_t pid = leaf->pid(), next = leaf->next_leaf();
+        steps++;
+        if (next == pid + 1) adjacent++;
+        else runs++;
+        distance += next > pid ? next - pid : pid - next;
+        leaf = bp_tree.open_leaf(next);
+    }
+    std::printf(
+        "%-11s %6zu leaves   adjacent %5.1f%%   runs %6zu   mean distance "
+        "%8.1f pages\n", name, steps + 1, 100.0 * adjacent / steps, runs,
+        distance / steps
+    );
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int rows = argc > 1 ? std::atoi(argv[1]) : 100000;
+
+    std::printf(
+        "%d rows of %u bytes per tree, %zu byte pages\n", rows, SLOT_SIZE,
+        PAGE_SIZE
+    );
+    run("apart", rows, false);
+    run("interleaved", rows, true);
+    return 0;
+}
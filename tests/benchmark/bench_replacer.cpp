@@ -0,0 +1,85 @@
+/* Compares the replacement policies of the Cache on pinning and unpinning
+ * pages from an in-memory file, for a working set that fits in the cache and
+ * for skewed accesses over a database several times larger than it.
+ * Usage: bench_replacer [page_count] [accesses] */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "frame_manager/cache/cache.hpp"
+#include "frame_manager/cache/frame_view.hpp"
+#include "frame_manager/disk_manager/disk_manager.hpp"
+#include "frame_manager/disk_manager/memory_file.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "minisql/options.hpp"
+
+using namespace minisql;
+
+namespace {
+
+constexpr std::size_t PAGE_SIZE = 4096;
+constexpr std::size_t CACHE_CAPACITY = 2000;
+
+/* Pin and unpin every page in pids in order through a Cache using policy.
+ * Returns the elapsed time in milliseconds. */
+double run(
+    DiskManager& disk, const std::vector<page_id_t>& pids, CachePolicy policy
+) {
+    Cache cache{disk, CACHE_CAPACITY, 0, policy};
+    std::size_t checksum = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (page_id_t pid : pids) checksum += cache.pin(pid).view<page_id_t>(0);
+    const auto end = std::chrono::steady_clock::now();
+    if (checksum == static_cast<std::size_t>(-1)) std::cout << checksum;
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void report(const char* name, double lru_ms, double clock_ms) {
+    std::printf(
+        "%-20s LRU %9.2f ms   CLOCK %9.2f ms   speedup %5.2fx\n",
+        name, lru_ms, clock_ms, lru_ms / clock_ms
+    );
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const page_id_t page_count = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const std::size_t accesses = argc > 2 ? std::atoi(argv[2]) : 2000000;
+
+    MemoryFile file{static_cast<std::streamoff>(page_count * PAGE_SIZE)};
+    DiskManager disk{file, 0, PAGE_SIZE, 0};
+    for (page_id_t pid = 0; pid < page_count; pid++) disk.extend();
+
+    std::mt19937 rng{42};
+    std::vector<page_id_t> hot(accesses), skewed(accesses);
+    std::uniform_int_distribution<page_id_t> hot_dist(0, CACHE_CAPACITY / 2);
+    for (page_id_t& pid : hot) pid = hot_dist(rng);
+    /* 90% of accesses to a tenth of the pages, the rest uniformly over all
+     * of them. */
+    std::uniform_int_distribution<page_id_t> all_dist(0, page_count - 1);
+    std::uniform_int_distribution<page_id_t> skew_dist(0, page_count / 10);
+    std::uniform_int_distribution<int> coin(0, 9);
+    for (page_id_t& pid : skewed)
+        pid = coin(rng) ? skew_dist(rng) : all_dist(rng);
+
+    std::printf(
+        "%u pages, cache of %zu frames, %zu accesses\n",
+        page_count, CACHE_CAPACITY, accesses
+    );
+    report(
+        "hot set",
+        run(disk, hot, CachePolicy::LRU), run(disk, hot, CachePolicy::CLOCK)
+    );
+    report(
+        "skewed",
+        run(disk, skewed, CachePolicy::LRU),
+        run(disk, skewed, CachePolicy::CLOCK)
+    );
+    return 0;
+}
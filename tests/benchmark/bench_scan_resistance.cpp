@@ -0,0 +1,136 @@
+/* Measures point lookups over a hot set of pages while table scans sweep a
+ * database several times the size of the cache, for each replacement policy.
+ * A scan-resistant policy keeps the lookup latency close to that with no
+ * scan running, and few lookups slow enough to have read their page (more than
+ * SLOW_LOOKUP) rather than finding it in the cache.
+ * Usage: bench_scan_resistance [page_count] [hot_pages] [lookups] */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "frame_manager/cache/cache.hpp"
+#include "frame_manager/cache/frame_view.hpp"
+#include "frame_manager/disk_manager/disk_manager.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/disk_manager/positional_file.hpp"
+#include "minisql/options.hpp"
+#include "platform.hpp"
+
+using namespace minisql;
+
+#ifdef MINISQL_POSIX
+
+namespace {
+
+constexpr std::size_t PAGE_SIZE = 4096;
+constexpr std::size_t CACHE_CAPACITY = 2000;
+
+// Scanned pages read between consecutive point lookups.
+constexpr std::size_t SCAN_STEP = 4;
+
+constexpr std::chrono::microseconds SLOW_LOOKUP {1};
+
+// The mean latency of a run of lookups and the fraction that were slow.
+struct Latency {
+    double mean_us;
+    double slow;
+};
+
+/* Run lookups random point lookups over the first hot_pages pages through a
+ * Cache using policy, scanning SCAN_STEP pages from the rest of the database
+ * between each lookup if scan is set. */
+Latency run(
+    DiskManager& disk, CachePolicy policy, page_id_t hot_pages,
+    std::size_t lookups, bool scan
+) {
+    Cache cache{disk, CACHE_CAPACITY, 0, policy};
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<page_id_t> hot(0, hot_pages - 1);
+    std::size_t checksum = 0;
+
+    // Warm the hot set up so that every policy starts from the same state.
+    for (int pass = 0; pass < 2; pass++)
+        for (page_id_t pid = 0; pid < hot_pages; pid++)
+            checksum += cache.pin(pid).view<page_id_t>(0);
+
+    page_id_t next_scanned = hot_pages;
+    std::chrono::steady_clock::duration lookup_time {};
+    std::size_t slow = 0;
+    for (std::size_t i = 0; i < lookups; i++) {
+        if (scan) {
+            for (std::size_t j = 0; j < SCAN_STEP; j++) {
+                checksum += cache.pin(next_scanned).view<page_id_t>(0);
+                if (++next_scanned == disk.page_count())
+                    next_scanned = hot_pages;
+            }
+        }
+        const auto start = std::chrono::steady_clock::now();
+        checksum += cache.pin(hot(rng)).view<page_id_t>(0);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        lookup_time += elapsed;
+        if (elapsed > SLOW_LOOKUP) slow++;
+    }
+    if (checksum == static_cast<std::size_t>(-1)) std::cout << checksum;
+    return {
+        std::chrono::duration<double, std::micro>(lookup_time).count() /
+            lookups,
+        static_cast<double>(slow) / lookups
+    };
+}
+
+void report(
+    const char* name, DiskManager& disk, CachePolicy policy,
+    page_id_t hot_pages, std::size_t lookups
+) {
+    const Latency idle = run(disk, policy, hot_pages, lookups, false);
+    const Latency scanning = run(disk, policy, hot_pages, lookups, true);
+    std::printf(
+        "%-6s idle %6.3f us (%5.1f%% slow)   during scan %6.3f us "
+        "(%5.1f%% slow)\n",
+        name, idle.mean_us, idle.slow * 100, scanning.mean_us,
+        scanning.slow * 100
+    );
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const page_id_t page_count = argc > 1 ? std::atoi(argv[1]) : 20000;
+    const page_id_t hot_pages = argc > 2 ? std::atoi(argv[2]) : 1000;
+    const std::size_t lookups = argc > 3 ? std::atoi(argv[3]) : 200000;
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "bench_scan_resistance.db";
+    std::filesystem::remove(path);
+    {
+        PositionalFile file{path};
+        DiskManager disk{file, 0, PAGE_SIZE, 0};
+        for (page_id_t pid = 0; pid < page_count; pid++) disk.extend();
+
+        std::printf(
+            "%u pages, %u hot, cache of %zu frames, %zu lookups\n",
+            page_count, hot_pages, CACHE_CAPACITY, lookups
+        );
+        report("LRU", disk, CachePolicy::LRU, hot_pages, lookups);
+        report("CLOCK", disk, CachePolicy::CLOCK, hot_pages, lookups);
+        report("2Q", disk, CachePolicy::TWO_QUEUE, hot_pages, lookups);
+    }
+    std::filesystem::remove(path);
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "bench_scan_resistance requires POSIX positional I/O"
+        << std::endl;
+    return 0;
+}
+
+#endif
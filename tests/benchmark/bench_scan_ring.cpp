@@ -0,0 +1,108 @@
+/* Measures how a bulk scan of a database several times the size of the cache
+ * disturbs a hot set of pages accessed at random alongside it, with the scan
+ * pinning pages through the whole cache or through a ScanRing. Reports the
+ * hit rate of the hot accesses and the time taken by the scan.
+ * Usage: bench_scan_ring [page_count] [hot_pages] [accesses_per_step] */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+
+#include "frame_manager/cache/cache.hpp"
+#include "frame_manager/cache/frame_view.hpp"
+#include "frame_manager/cache/scan_ring.hpp"
+#include "frame_manager/disk_manager/disk_manager.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/disk_manager/positional_file.hpp"
+#include "platform.hpp"
+
+using namespace minisql;
+
+#ifdef MINISQL_POSIX
+
+namespace {
+
+constexpr std::size_t PAGE_SIZE = 4096;
+constexpr std::size_t CACHE_CAPACITY = 2000;
+constexpr std::size_t RING_SIZE = 128;
+
+/* Scan every page of disk through a Cache, through a ScanRing if ring is
+ * set, making accesses_per_step random accesses to the first hot_pages pages
+ * after each page scanned. The hot pages are accessed beforehand so that they
+ * start out cached. Prints the hit rate of the hot accesses. */
+void run(
+    const char* name, DiskManager& disk, page_id_t hot_pages,
+    std::size_t accesses_per_step, bool ring
+) {
+    Cache cache{disk, CACHE_CAPACITY};
+    ScanRing scan_ring{RING_SIZE};
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<page_id_t> hot(0, hot_pages - 1);
+    for (page_id_t pid = 0; pid < hot_pages; pid++) cache.pin(pid);
+
+    std::uint64_t hits = 0, accesses = 0;
+    std::chrono::steady_clock::duration scanning {0};
+    std::size_t checksum = 0;
+    for (page_id_t pid = hot_pages; pid < disk.page_count(); pid++) {
+        const auto start = std::chrono::steady_clock::now();
+        checksum += cache.pin(pid, ring ? &scan_ring : nullptr)
+            .view<page_id_t>(0);
+        scanning += std::chrono::steady_clock::now() - start;
+
+        for (std::size_t i = 0; i < accesses_per_step; i++) {
+            const std::uint64_t before = cache.stats().hits;
+            checksum += cache.pin(hot(rng)).view<page_id_t>(0);
+            hits += cache.stats().hits - before;
+            accesses++;
+        }
+    }
+    if (checksum == static_cast<std::size_t>(-1)) std::cout << checksum;
+
+    std::printf(
+        "%-8s hot hits %5.1f%%   scan %7.2f ms\n", name,
+        100.0 * hits / accesses,
+        std::chrono::duration<double, std::milli>(scanning).count()
+    );
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const page_id_t page_count = argc > 1 ? std::atoi(argv[1]) : 20000;
+    const page_id_t hot_pages = argc > 2 ? std::atoi(argv[2]) : 1500;
+    const std::size_t accesses_per_step = argc > 3 ? std::atoi(argv[3]) : 1;
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "bench_scan_ring.db";
+    std::filesystem::remove(path);
+    {
+        PositionalFile file{path};
+        DiskManager disk{file, 0, PAGE_SIZE, 0};
+        for (page_id_t pid = 0; pid < page_count; pid++) disk.extend();
+
+        std::printf(
+            "%u pages, %u hot, cache of %zu frames, ring of %zu, %zu hot "
+            "accesses per page scanned\n", page_count, hot_pages,
+            CACHE_CAPACITY, RING_SIZE, accesses_per_step
+        );
+        run("no ring", disk, hot_pages, accesses_per_step, false);
+        run("ring", disk, hot_pages, accesses_per_step, true);
+    }
+    std::filesystem::remove(path);
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "bench_scan_ring requires POSIX positional I/O" << std::endl;
+    return 0;
+}
+
+#endif
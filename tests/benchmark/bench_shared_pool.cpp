@@ -0,0 +1,119 @@
+/* Compares giving each of many databases a private buffer pool with a share of
+ * a memory budget against one pool shared by all of them with the whole
+ * budget, when one database is hot and needs more pages than its share while
+ * the rest need few. Reports the hit rates of the hot database, the others and
+ * overall.
+ * Usage: bench_shared_pool [databases] [budget_pages] [hot_pages] [accesses] */
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <ios>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "frame_manager/cache/buffer_pool.hpp"
+#include "frame_manager/cache/cache.hpp"
+#include "frame_manager/cache/frame_view.hpp"
+#include "frame_manager/disk_manager/disk_manager.hpp"
+#include "frame_manager/disk_manager/memory_file.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "minisql/cache_stats.hpp"
+
+using namespace minisql;
+
+namespace {
+
+constexpr std::size_t PAGE_SIZE = 4096;
+
+// Pages used by each database other than the hot one.
+constexpr page_id_t COLD_PAGES = 20;
+
+// Fraction of accesses made to the hot database.
+constexpr double HOT_SHARE = 0.5;
+
+// A database held in memory, with the Cache giving access to it.
+struct Db {
+    explicit Db(page_id_t pages)
+        : file{static_cast<std::streamoff>(PAGE_SIZE * pages)},
+          disk{file, 0, PAGE_SIZE, 0} {
+        for (page_id_t pid = 0; pid < pages; pid++) disk.extend();
+    }
+
+    MemoryFile file;
+    DiskManager disk;
+    std::unique_ptr<Cache> cache;
+};
+
+/* Access random pages of the databases (the first of them hot, using
+ * hot_pages) through Caches with private pools splitting budget pages between
+ * them, or through Caches sharing one pool of budget pages if shared is set.
+ * Prints the hit rates. */
+void run(
+    const char* name, std::vector<std::unique_ptr<Db>>& dbs,
+    std::size_t budget, page_id_t hot_pages, std::size_t accesses, bool shared
+) {
+    auto pool = std::make_shared<BufferPool>(PAGE_SIZE, budget);
+    for (auto& db : dbs) {
+        db->cache = shared ? std::make_unique<Cache>(db->disk, pool)
+            : std::make_unique<Cache>(db->disk, budget / dbs.size());
+    }
+
+    std::mt19937 rng{42};
+    std::bernoulli_distribution to_hot(HOT_SHARE);
+    std::uniform_int_distribution<std::size_t> cold_db(1, dbs.size() - 1);
+    std::uniform_int_distribution<page_id_t> hot_pid(0, hot_pages - 1);
+    std::uniform_int_distribution<page_id_t> cold_pid(0, COLD_PAGES - 1);
+    std::size_t checksum = 0;
+    for (std::size_t i = 0; i < accesses; i++) {
+        if (to_hot(rng)) {
+            checksum += dbs[0]->cache->pin(hot_pid(rng)).view<page_id_t>(0);
+        }
+        else {
+            Cache& cache = *dbs[cold_db(rng)]->cache;
+            checksum += cache.pin(cold_pid(rng)).view<page_id_t>(0);
+        }
+    }
+    if (checksum == static_cast<std::size_t>(-1)) std::printf("%zu", checksum);
+
+    CacheStats cold, total;
+    for (std::size_t i = 0; i < dbs.size(); i++) {
+        const CacheStats& stats = dbs[i]->cache->stats();
+        if (i) {
+            cold.hits += stats.hits;
+            cold.misses += stats.misses;
+        }
+        total.hits += stats.hits;
+        total.misses += stats.misses;
+    }
+    std::printf(
+        "%-8s hot %5.1f%%   others %5.1f%%   overall %5.1f%%\n", name,
+        dbs[0]->cache->stats().hit_rate() * 100, cold.hit_rate() * 100,
+        total.hit_rate() * 100
+    );
+    for (auto& db : dbs) db->cache.reset();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t databases = argc > 1 ? std::atoi(argv[1]) : 30;
+    const std::size_t budget = argc > 2 ? std::atoi(argv[2]) : 3000;
+    const page_id_t hot_pages = argc > 3 ? std::atoi(argv[3]) : 2000;
+    const std::size_t accesses = argc > 4 ? std::atoi(argv[4]) : 1000000;
+
+    std::vector<std::unique_ptr<Db>> dbs;
+    dbs.push_back(std::make_unique<Db>(hot_pages));
+    for (std::size_t i = 1; i < databases; i++)
+        dbs.push_back(std::make_unique<Db>(COLD_PAGES));
+
+    std::printf(
+        "%zu databases (one using %u pages, the rest %u), budget of %zu "
+        "pages, %zu accesses\n",
+        databases, hot_pages, COLD_PAGES, budget, accesses
+    );
+    run("private", dbs, budget, hot_pages, accesses, false);
+    run("shared", dbs, budget, hot_pages, accesses, true);
+    return 0;
+}
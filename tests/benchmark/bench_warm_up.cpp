@@ -0,0 +1,150 @@
+/* Measures the first point queries after reopening a database whose queries
+ * concentrate on a hot range of rows, with and without warming the buffer pool
+ * up from the pages it held when last closed. The kernel's cache of the file
+ * is dropped before each reopen, as after a restart. Reports how long the
+ * warm-up took and the latency and hit rate of the first queries.
+ * Usage: bench_warm_up [rows] [hot_rows] [queries] */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "minisql/cache_stats.hpp"
+#include "minisql/connection.hpp"
+#include "minisql/options.hpp"
+#include "platform.hpp"
+
+#ifdef MINISQL_POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace minisql;
+
+#ifdef MINISQL_POSIX
+
+namespace {
+
+constexpr std::size_t CACHE_CAPACITY = 2000;
+
+// Evict the pages of the file at path from the kernel's cache.
+void drop_os_cache(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+}
+
+// Run queries random point queries over the first hot_rows rows.
+void query_hot(Connection& connection, int hot_rows, std::size_t queries) {
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> hot(0, hot_rows - 1);
+    for (std::size_t i = 0; i < queries; i++) {
+        for (auto& row : connection.query(
+            "SELECT * FROM t WHERE id = " + std::to_string(hot(rng)) + ";"
+        )) (void)row;
+    }
+}
+
+/* Reopen the database at path, with warm_up, after dropping the kernel's
+ * cache of it, and time queries point queries over the first hot_rows rows.
+ * Prints the latency and hit rate of the queries. */
+void run(
+    const char* name, const std::filesystem::path& path, bool warm_up,
+    int hot_rows, std::size_t queries
+) {
+    Options options;
+    options.cache_capacity = CACHE_CAPACITY;
+    options.warm_up = warm_up;
+    drop_os_cache(path);
+
+    const auto open_start = std::chrono::steady_clock::now();
+    Connection connection{path, options};
+    const auto opened = std::chrono::steady_clock::now() - open_start;
+
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<int> hot(0, hot_rows - 1);
+    std::vector<double> latencies;
+    for (std::size_t i = 0; i < queries; i++) {
+        const std::string sql =
+            "SELECT * FROM t WHERE id = " + std::to_string(hot(rng)) + ";";
+        const auto start = std::chrono::steady_clock::now();
+        for (auto& row : connection.query(sql)) (void)row;
+        latencies.push_back(std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start
+        ).count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    double total = 0;
+    for (double latency : latencies) total += latency;
+
+    const WarmUpStats warm = connection.warm_up_stats();
+    std::printf(
+        "%-8s open %7.2f ms (warm-up %5llu pages, %7.2f ms)   query mean "
+        "%6.1f us   p99 %7.1f us   hits %5.1f%%\n",
+        name, std::chrono::duration<double, std::milli>(opened).count(),
+        static_cast<unsigned long long>(warm.pages),
+        warm.duration.count() / 1000.0, total / latencies.size(),
+        latencies[latencies.size() * 99 / 100],
+        connection.cache_stats().hit_rate() * 100
+    );
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int rows = argc > 1 ? std::atoi(argv[1]) : 200000;
+    const int hot_rows = argc > 2 ? std::atoi(argv[2]) : 20000;
+    const std::size_t queries = argc > 3 ? std::atoi(argv[3]) : 2000;
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "bench_warm_up.db";
+    std::filesystem::remove(path);
+    {
+        Connection connection{path};
+        connection.exec(
+            "CREATE TABLE t (id INT, payload TEXT(200), PRIMARY KEY(id));"
+        );
+        for (int id = 0; id < rows; id++) {
+            connection.exec(
+                "INSERT INTO t (id, payload) VALUES (" + std::to_string(id) +
+                ", \"payload\");"
+            );
+        }
+    }
+    std::printf(
+        "%d rows, %d hot, cache of %zu pages, first %zu queries\n", rows,
+        hot_rows, CACHE_CAPACITY, queries
+    );
+
+    /* Each run is preceded by a session which leaves the pages of the hot
+     * rows in the cache, and records them on closing. */
+    Options options;
+    options.cache_capacity = CACHE_CAPACITY;
+    options.warm_up = true;
+    for (bool warm_up : {false, true}) {
+        {
+            Connection connection{path, options};
+            query_hot(connection, hot_rows, queries * 10);
+        }
+        run(warm_up ? "warm-up" : "cold", path, warm_up, hot_rows, queries);
+    }
+    std::filesystem::remove(path);
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "bench_warm_up requires POSIX" << std::endl;
+    return 0;
+}
+
+#endif
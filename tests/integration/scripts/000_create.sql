@@ -8,4 +8,8 @@ CREATE TABLE t3 (text TEXT(16));
 
 # basic combinations
 CREATE TABLE t4 (int INT, real REAL, text TEXT(16));
-CREATE TABLE t5 (text1 TEXT(16), text2 TEXT(64), text3 TEXT(256));
\ No newline at end of file
+CREATE TABLE t5 (text1 TEXT(16), text2 TEXT(64), text3 TEXT(256));
+
+# cache priorities
+CREATE TABLE t6 (int INT) WITH (cache = keep);
+CREATE TABLE t7 (int INT, PRIMARY KEY (int)) WITH (cache = normal);
\ No newline at end of file
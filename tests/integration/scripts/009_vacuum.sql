@@ -0,0 +1,21 @@
+# 009_vacuum
+# Tests VACUUM statements
+
+# nothing to reclaim
+VACUUM;
+
+# dropped tables
+CREATE TABLE t (int INT, real REAL, text TEXT(5));
+INSERT INTO t VALUES
+    (1, 0.1, "one"), (2, 0.2, "two"), (3, 0.3, "three"), (4, 0.4, "four");
+CREATE TABLE u (int INT, text TEXT(5), PRIMARY KEY(int));
+INSERT INTO u VALUES (1, "one"), (2, "two");
+DROP TABLE t;
+DROP TABLE u;
+VACUUM;
+
+# table recreated in reclaimed pages
+CREATE TABLE t (int INT, text TEXT(5));
+INSERT INTO t VALUES (5, "five"), (6, "six");
+VACUUM;
+SELECT * FROM t;
@@ -0,0 +1,84 @@
+# 010_bulk_insert
+# Tests INSERTs of many rows and CREATE TABLE ... AS SELECT statements
+
+# many rows into an empty table, out of key order
+CREATE TABLE t (int INT, text TEXT(5), PRIMARY KEY(int));
+INSERT INTO t VALUES
+    (21, "v21"), (50, "v50"), (60, "v60"), (43, "v43"), (16, "v16"),
+    (69, "v69"), (97, "v97"), (67, "v67"), (94, "v94"), (29, "v29"),
+    (86, "v86"), (89, "v89"), (74, "v74"), (25, "v25"), (40, "v40"), (7, "v7"),
+    (70, "v70"), (63, "v63"), (13, "v13"), (47, "v47"), (6, "v6"), (55, "v55"),
+    (39, "v39"), (24, "v24"), (3, "v3"), (68, "v68"), (72, "v72"), (11, "v11"),
+    (18, "v18"), (57, "v57"), (44, "v44"), (80, "v80"), (76, "v76"),
+    (64, "v64"), (82, "v82"), (95, "v95"), (85, "v85"), (52, "v52"),
+    (93, "v93"), (14, "v14"), (10, "v10"), (32, "v32"), (51, "v51"),
+    (96, "v96"), (84, "v84"), (87, "v87"), (65, "v65"), (27, "v27"),
+    (28, "v28"), (90, "v90"), (42, "v42"), (88, "v88"), (92, "v92"),
+    (49, "v49"), (23, "v23"), (34, "v34"), (19, "v19"), (12, "v12"), (8, "v8"),
+    (15, "v15"), (0, "v0"), (37, "v37"), (2, "v2"), (75, "v75"), (56, "v56"),
+    (30, "v30"), (71, "v71"), (78, "v78"), (81, "v81"), (38, "v38"),
+    (22, "v22"), (58, "v58"), (33, "v33"), (36, "v36"), (79, "v79"),
+    (48, "v48"), (45, "v45"), (77, "v77"), (17, "v17"), (53, "v53"), (5, "v5"),
+    (46, "v46"), (31, "v31"), (9, "v9"), (41, "v41"), (91, "v91"), (66, "v66"),
+    (98, "v98"), (20, "v20"), (83, "v83"), (35, "v35"), (62, "v62"),
+    (59, "v59"), (26, "v26"), (1, "v1"), (99, "v99"), (61, "v61"), (54, "v54"),
+    (4, "v4"), (73, "v73");
+SELECT * FROM t WHERE int < 3;
+SELECT * FROM t WHERE int >= 98;
+
+# many rows into a non-empty table
+INSERT INTO t VALUES
+    (100, "v100"), (101, "v101"), (102, "v102"), (103, "v103"), (104, "v104"),
+    (105, "v105"), (106, "v106"), (107, "v107"), (108, "v108"), (109, "v109"),
+    (110, "v110"), (111, "v111"), (112, "v112"), (113, "v113"), (114, "v114"),
+    (115, "v115"), (116, "v116"), (117, "v117"), (118, "v118"), (119, "v119"),
+    (120, "v120"), (121, "v121"), (122, "v122"), (123, "v123"), (124, "v124"),
+    (125, "v125"), (126, "v126"), (127, "v127"), (128, "v128"), (129, "v129"),
+    (130, "v130"), (131, "v131"), (132, "v132"), (133, "v133"), (134, "v134"),
+    (135, "v135"), (136, "v136"), (137, "v137"), (138, "v138"), (139, "v139"),
+    (140, "v140"), (141, "v141"), (142, "v142"), (143, "v143"), (144, "v144"),
+    (145, "v145"), (146, "v146"), (147, "v147"), (148, "v148"), (149, "v149"),
+    (150, "v150"), (151, "v151"), (152, "v152"), (153, "v153"), (154, "v154"),
+    (155, "v155"), (156, "v156"), (157, "v157"), (158, "v158"), (159, "v159"),
+    (160, "v160"), (161, "v161"), (162, "v162"), (163, "v163"), (164, "v164"),
+    (165, "v165"), (166, "v166"), (167, "v167"), (168, "v168"), (169, "v169");
+SELECT * FROM t WHERE int > 167;
+
+# many rows into an empty table, with a duplicate key
+CREATE TABLE u (int INT, PRIMARY KEY(int));
+INSERT INTO u VALUES
+    (0), (1), (2), (3), (4), (5), (6), (7), (8), (9), (10), (11), (12), (13),
+    (14), (15), (16), (17), (18), (19), (20), (21), (22), (23), (24), (25),
+    (26), (27), (28), (29), (30), (31), (32), (33), (34), (35), (36), (37),
+    (38), (39), (40), (41), (42), (43), (44), (45), (46), (47), (48), (49),
+    (50), (51), (52), (53), (54), (55), (56), (57), (58), (59), (60), (61),
+    (62), (63), (10), (64), (65), (66), (67), (68), (69);
+SELECT * FROM u WHERE int > 61;
+
+# many rows into an empty table without a primary key
+CREATE TABLE v (int INT);
+INSERT INTO v VALUES
+    (21), (50), (60), (43), (16), (69), (97), (67), (94), (29), (86), (89),
+    (74), (25), (40), (7), (70), (63), (13), (47), (6), (55), (39), (24), (3),
+    (68), (72), (11), (18), (57), (44), (80), (76), (64), (82), (95), (85),
+    (52), (93), (14), (10), (32), (51), (96), (84), (87), (65), (27), (28),
+    (90), (42), (88), (92), (49), (23), (34), (19), (12), (8), (15), (0), (37),
+    (2), (75), (56), (30), (71), (78), (81), (38);
+SELECT rowid, int FROM v WHERE rowid < 3;
+
+# creating a table from a select
+CREATE TABLE w AS SELECT text, int FROM t WHERE int < 3;
+SELECT * FROM w;
+SELECT rowid FROM w;
+INSERT INTO w VALUES ("v0", 0);
+SELECT * FROM w WHERE int = 0;
+CREATE TABLE x AS SELECT * FROM t WHERE int >= 168;
+SELECT * FROM x;
+CREATE TABLE y AS SELECT * FROM t WHERE int > 1000;
+SELECT * FROM y;
+
+# invalid selects
+CREATE TABLE w AS SELECT * FROM t;
+CREATE TABLE z AS SELECT * FROM nothing;
+CREATE TABLE z AS SELECT nothing FROM t;
+CREATE TABLE z AS SELECT rowid FROM v;
@@ -24,4 +24,9 @@ CREATE TABLE t2 (text TEXT);
 CREATE TABLE t2 (text STRING);
 
 # column types create too wide of a table
-CREATE TABLE t2 (text TEXT(509));
\ No newline at end of file
+CREATE TABLE t2 (text TEXT(509));
+
+# invalid cache options
+CREATE TABLE t2 (int INT) WITH (cache = pinned);
+CREATE TABLE t2 (int INT) WITH (size = keep);
+CREATE TABLE t2 (int INT) WITH ();
\ No newline at end of file
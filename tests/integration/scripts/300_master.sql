@@ -8,6 +8,8 @@ CREATE TABLE master (name TEXT(16), sql TEXT(256), root INT, next_rowid INT);
 CREATE TABLE t1 (int INT);
 CREATE TABLE t2 (real REAL);
 CREATE TABLE t3 (text TEXT(16));
+CREATE TABLE t4 (int INT) WITH (cache = keep);
+CREATE TABLE t5 WITH (cache = keep) AS SELECT * FROM t1;
 SELECT * FROM master;
 
 # INSERT
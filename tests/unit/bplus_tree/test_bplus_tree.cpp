@@ -6,6 +6,8 @@
 #include <cstddef>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <random>
 #include <typeinfo>
 #include <vector>
 
@@ -17,6 +19,8 @@
 #include "frame_manager/disk_manager/page_id_t.hpp"
 #include "frame_manager/frame_manager.hpp"
 #include "headers.hpp"
+#include "minisql/cache_stats.hpp"
+#include "span.hpp"
 
 #include "bplus_tree/test_node.hpp"
 #include "utils.hpp"
@@ -143,6 +147,10 @@ void test_erase() {
     std::cout << "- test_erase passed" << std::endl;
 }
 
+/* Tests:
+ * - destroying a tree frees all of its pages, pinning only the internal
+ *   nodes and the pages down its left edge
+ * - the freed pages are reused */
 template <typename Key>
 void test_destroy() {
     std::filesystem::path path = make_temp_path();
@@ -177,7 +185,15 @@ void test_destroy() {
 
         page_id_t next_pid = fm.allocate().pid();
         fm.deallocate(next_pid);
+        const page_id_t tree_pages = next_pid;
+        const CacheStats before = fm.cache_stats();
         bp_tree.destroy();
+        const CacheStats after = fm.cache_stats();
+        assert(fm.free_page_count() == tree_pages + 1);
+        assert(
+            after.hits + after.misses - before.hits - before.misses <
+            tree_pages / 4
+        );
         bp_tree = BPlusTree{&fm, key_size_, key_size_};
 
         for (int i = 0; i < max_slots; i++) {
@@ -196,6 +212,149 @@ void test_destroy() {
     std::cout << "- test_destroy passed" << std::endl;
 }
 
+/* Tests:
+ * - a root leaf has no siblings
+ * - sibling_leaves follows the leaf chain up to the end of the parent */
+template <typename Key>
+void test_sibling_leaves() {
+    std::filesystem::path path = make_temp_path();
+    create_file(path);
+    std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+    {
+        const std::size_t page_size = 512;
+        FrameManager fm{file, 0, page_size, 0, 1000};
+        const Node::key_size_t key_size_ = key_size<Key>();
+        BPlusTree bp_tree{&fm, key_size_, key_size_};
+
+        auto insert = [&](int i) {
+            const Key key = generate<Key>(i);
+            auto leaf_node = bp_tree.seek_leaf<Key>(key);
+            Node::size_t slot =
+                BPlusTree::seek_slot<Key>(leaf_node.get(), key);
+            std::vector<std::byte> bytes{key_size_};
+            byte_io::write<Key>(bytes, 0, key);
+            bp_tree.insert_into<Key>(leaf_node.get(), slot, bytes);
+        };
+
+        insert(0);
+        assert(bp_tree.sibling_leaves(
+            bp_tree.seek_leaf<Key>(generate<Key>(0)).get(), 10
+        ).empty());
+
+        for (int i = 1; i < 2000; i++) insert(i);
+        std::vector<Key> keys;
+        for (int i = 0; i < 2000; i++) keys.push_back(generate<Key>(i));
+        auto leaf_node = bp_tree.seek_leaf<Key>(
+            *std::min_element(keys.begin(), keys.end())
+        );
+        const std::size_t n = 3;
+        while (true) {
+            std::vector<page_id_t> siblings =
+                bp_tree.sibling_leaves(leaf_node.get(), n);
+            assert(siblings.size() <= n);
+            auto sibling = std::make_unique<LeafNode>(fm.pin(leaf_node->pid()));
+            for (page_id_t pid : siblings) {
+                assert(sibling->next_leaf() == pid);
+                sibling = bp_tree.open_leaf(pid);
+                assert(sibling->parent() == leaf_node->parent());
+            }
+            if (siblings.size() < n && !sibling->is_rightmost())
+                assert(bp_tree.open_leaf(sibling->next_leaf())->parent() !=
+                    leaf_node->parent());
+            if (leaf_node->is_rightmost()) break;
+            leaf_node = bp_tree.open_leaf(leaf_node->next_leaf());
+        }
+    }
+    delete_path(path);
+    std::cout << "- test_sibling_leaves passed" << std::endl;
+}
+
+/* Tests:
+ * - shuffled slots are loaded into an empty tree, each found by seek_leaf
+ * - the leaf chain holds every key in order, and no leaf but the root is below
+ *   its minimum size
+ * - the tree is usable for inserts after loading
+ * - a lower fill factor uses more pages
+ * - loading into a non-empty tree or with a duplicate key returns false */
+template <typename Key>
+void test_bulk_load() {
+    std::filesystem::path path = make_temp_path();
+    create_file(path);
+    std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+    {
+        const std::size_t page_size = 512;
+        FrameManager fm{file, 0, page_size, 0, 1000};
+        const Node::key_size_t key_size_ = key_size<Key>();
+        const Node::size_t leaf_max_slots =
+            (page_size - LeafNodeHeader::SIZE) / key_size_;
+        const int n = 5000;
+
+        std::vector<std::vector<std::byte>> bytes;
+        for (int i = 0; i < n; i++) {
+            bytes.emplace_back(key_size_);
+            byte_io::write<Key>(bytes.back(), 0, generate<Key>(i));
+        }
+        std::vector<span<std::byte>> slots{bytes.begin(), bytes.end()};
+        std::mt19937 rng{0};
+        std::shuffle(slots.begin(), slots.end(), rng);
+
+        auto load = [&](double fill_factor) {
+            BPlusTree bp_tree{&fm, key_size_, key_size_};
+            const page_id_t before = fm.page_count() - fm.free_page_count();
+            assert(bp_tree.bulk_load<Key>(slots, fill_factor));
+            const page_id_t pages =
+                fm.page_count() - fm.free_page_count() - before;
+
+            for (int i = 0; i < n; i++) {
+                const Key key = generate<Key>(i);
+                auto leaf_node = bp_tree.seek_leaf<Key>(key);
+                Node::size_t slot =
+                    BPlusTree::seek_slot<Key>(leaf_node.get(), key);
+                assert(leaf_node->template key<Key>(slot) == key);
+            }
+
+            std::vector<Key> keys;
+            for (int i = 0; i < n; i++) keys.push_back(generate<Key>(i));
+            std::sort(keys.begin(), keys.end());
+            auto leaf_node = bp_tree.seek_leaf<Key>(keys.front());
+            std::size_t seen = 0;
+            while (true) {
+                assert(leaf_node->size() >= leaf_max_slots / 2);
+                for (Node::size_t slot = 0; slot < leaf_node->size(); slot++)
+                    assert(leaf_node->template key<Key>(slot) == keys[seen++]);
+                if (leaf_node->is_rightmost()) break;
+                leaf_node = bp_tree.open_leaf(leaf_node->next_leaf());
+            }
+            assert(seen == keys.size());
+
+            std::vector<std::byte> extra(key_size_);
+            const Key key = generate<Key>(n);
+            byte_io::write<Key>(extra, 0, key);
+            assert(!bp_tree.bulk_load<Key>({span<std::byte>{extra}}, 1.0));
+            leaf_node = bp_tree.seek_leaf<Key>(key);
+            bp_tree.insert_into<Key>(
+                leaf_node.get(),
+                BPlusTree::seek_slot<Key>(leaf_node.get(), key), extra
+            );
+            leaf_node = bp_tree.seek_leaf<Key>(key);
+            assert(leaf_node->template key<Key>(
+                BPlusTree::seek_slot<Key>(leaf_node.get(), key)
+            ) == key);
+            return pages;
+        };
+
+        const page_id_t full = load(1.0);
+        assert(full <= n / leaf_max_slots + n / leaf_max_slots / 8 + 2);
+        assert(load(0.5) > full * 3 / 2);
+
+        slots.push_back(slots.front());
+        BPlusTree bp_tree{&fm, key_size_, key_size_};
+        assert(!bp_tree.bulk_load<Key>(slots, 1.0));
+    }
+    delete_path(path);
+    std::cout << "- test_bulk_load passed" << std::endl;
+}
+
 template <typename Key>
 void run_tests() {
     std::cout << "Running tests for " << typeid(Key).name() << ":" << std::endl;
@@ -203,6 +362,8 @@ void run_tests() {
     test_insert<Key>();
     test_erase<Key>();
     test_destroy<Key>();
+    test_sibling_leaves<Key>();
+    test_bulk_load<Key>();
 }
 
 int main() {
@@ -0,0 +1,136 @@
+#include "bplus_tree/reclaimer.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "bplus_tree/bplus_tree.hpp"
+#include "bplus_tree/node.hpp"
+#include "byte_io.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/frame_manager.hpp"
+#include "minisql/cache_stats.hpp"
+
+#include "utils.hpp"
+
+using namespace minisql;
+
+namespace {
+
+const std::size_t page_size = 512;
+
+// Return the pages read from or written to fm since before was taken.
+std::size_t pins(const FrameManager& fm, const CacheStats& before) {
+    const CacheStats after = fm.cache_stats();
+    return after.hits + after.misses - before.hits - before.misses;
+}
+
+// Return a BPlusTree of n int keys, in a File with no other pages in use.
+BPlusTree build_tree(FrameManager& fm, int n) {
+    const Node::key_size_t key_size_ = key_size<int>();
+    BPlusTree bp_tree{&fm, key_size_, key_size_};
+    for (int i = 0; i < n; i++) {
+        auto leaf_node = bp_tree.seek_leaf<int>(i);
+        Node::size_t slot = BPlusTree::seek_slot<int>(leaf_node.get(), i);
+        std::vector<std::byte> bytes{key_size_};
+        byte_io::write<int>(bytes, 0, i);
+        bp_tree.insert_into<int>(leaf_node.get(), slot, bytes);
+    }
+    return bp_tree;
+}
+
+} // namespace
+
+/* Tests:
+ * - adding a tree frees nothing, and each step frees at most budget pages
+ * - freeing every page of the tree pins far fewer pages than it has, as
+ *   leaves are never read
+ * - once all are freed, a step frees nothing */
+void test_step() {
+    std::filesystem::path path = make_temp_path();
+    create_file(path);
+    std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+    {
+        FrameManager fm{file, 0, page_size, 0, 1000};
+        BPlusTree bp_tree = build_tree(fm, 50000);
+        const page_id_t tree_pages = fm.page_count();
+        assert(fm.free_page_count() == 0);
+
+        Reclaimer reclaimer{&fm};
+        const CacheStats before = fm.cache_stats();
+        reclaimer.add(bp_tree);
+        assert(!reclaimer.done() && fm.free_page_count() == 0);
+
+        std::size_t freed = 0;
+        for (std::size_t n; (n = reclaimer.step(100)); freed += n)
+            assert(n <= 100);
+        assert(freed == tree_pages && reclaimer.done());
+        assert(fm.free_page_count() == tree_pages);
+        assert(pins(fm, before) < tree_pages / 4);
+        assert(reclaimer.step(100) == 0);
+    }
+    delete_path(path);
+    std::cout << "- test_step passed" << std::endl;
+}
+
+/* Tests:
+ * - nothing is saved once all pages are freed
+ * - pending Entries saved part way through are loaded in the same order, and
+ *   the pages they were saved to are kept until taken
+ * - pages taken instead of freed are left in use until the caller frees them
+ * - reclamation resumes from the loaded Entries and frees every page */
+void test_save_load() {
+    std::filesystem::path path = make_temp_path();
+    create_file(path);
+    std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+    {
+        FrameManager fm{file, 0, page_size, 0, 1000};
+        assert(Reclaimer{&fm}.save() == nullpid);
+
+        BPlusTree first = build_tree(fm, 20000);
+        BPlusTree second = build_tree(fm, 20000);
+        const page_id_t used = fm.page_count();
+
+        Reclaimer reclaimer{&fm};
+        reclaimer.add(first);
+        reclaimer.add(second);
+        std::size_t freed = reclaimer.step(50);
+        const std::vector<Reclaimer::Entry> pending = reclaimer.entries();
+        assert(pending.size() > 1);
+        const page_id_t first_block = reclaimer.save();
+        assert(first_block != nullpid);
+
+        Reclaimer loaded{&fm};
+        loaded.load(first_block);
+        assert(loaded.entries().size() == pending.size());
+        for (std::size_t i = 0; i < pending.size(); i++) {
+            assert(loaded.entries()[i].root == pending[i].root);
+            assert(loaded.entries()[i].height == pending[i].height);
+        }
+        std::vector<page_id_t> blocks = loaded.take_blocks();
+        assert(!blocks.empty() && blocks[0] == first_block);
+        assert(loaded.take_blocks().empty());
+        fm.deallocate(blocks);
+
+        const page_id_t free_pages = fm.free_page_count();
+        std::vector<page_id_t> taken = loaded.take_pages(50);
+        assert(taken.size() == 50 && fm.free_page_count() == free_pages);
+        fm.deallocate(taken);
+        freed += taken.size();
+
+        while (const std::size_t n = loaded.step(1000)) freed += n;
+        assert(freed == used);
+        assert(fm.free_page_count() == fm.page_count() - 1);
+    }
+    delete_path(path);
+    std::cout << "- test_save_load passed" << std::endl;
+}
+
+int main() {
+    test_step();
+    test_save_load();
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "compression/lz.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "exceptions/engine_exceptions.hpp"
+
+using namespace minisql;
+
+// Compress then decompress src, asserting that it round trips.
+std::size_t round_trip(const std::vector<std::byte>& src) {
+    std::vector<std::byte> compressed(src.size() * 2 + 16);
+    const std::size_t size = lz::compress(
+        src.data(), src.size(), compressed.data(), compressed.size()
+    );
+    assert(size);
+    std::vector<std::byte> dst(src.size());
+    lz::decompress(compressed.data(), size, dst.data(), dst.size());
+    assert(dst == src);
+    return size;
+}
+
+/* Tests:
+ * - a zeroed page compresses to a few bytes
+ * - a page of padded text compresses well
+ * - random bytes and tiny inputs still round trip */
+void test_round_trip() {
+    assert(round_trip(std::vector<std::byte>(4096)) < 32);
+
+    std::vector<std::byte> padded(4096);
+    for (std::size_t slot = 0; slot < 4096 / 128; slot++)
+        for (std::size_t i = 0; i < 10; i++)
+            padded[slot * 128 + i] = static_cast<std::byte>('a' + slot + i);
+    assert(round_trip(padded) < 1024);
+
+    std::mt19937 rng{0};
+    std::vector<std::byte> random(4096);
+    for (std::byte& b : random) b = static_cast<std::byte>(rng());
+    round_trip(random);
+
+    round_trip({});
+    round_trip({std::byte{1}, std::byte{2}, std::byte{3}});
+    std::cout << "- test_round_trip passed" << std::endl;
+}
+
+/* Tests:
+ * - compressing into too small a buffer returns 0
+ * - malformed input throws a CompressionException */
+void test_errors() {
+    std::mt19937 rng{0};
+    std::vector<std::byte> random(4096);
+    for (std::byte& b : random) b = static_cast<std::byte>(rng());
+    std::vector<std::byte> small(1024);
+    assert(!lz::compress(random.data(), random.size(), small.data(), 1024));
+
+    std::vector<std::byte> zeros(4096), compressed(64);
+    const std::size_t size = lz::compress(
+        zeros.data(), zeros.size(), compressed.data(), compressed.size()
+    );
+    std::vector<std::byte> dst(4096);
+    try {
+        lz::decompress(compressed.data(), size, dst.data(), 2048);
+        assert(false);
+    }
+    catch (const CompressionException&) {}
+    try {
+        lz::decompress(compressed.data(), size - 2, dst.data(), dst.size());
+        assert(false);
+    }
+    catch (const CompressionException&) {}
+    std::vector<std::byte> bad {std::byte{0x01}, std::byte{1}, std::byte{0}};
+    try {
+        lz::decompress(bad.data(), bad.size(), dst.data(), dst.size());
+        assert(false);
+    }
+    catch (const CompressionException&) {}
+    std::cout << "- test_errors passed" << std::endl;
+}
+
+int main() {
+    test_round_trip();
+    test_errors();
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
\ No newline at end of file
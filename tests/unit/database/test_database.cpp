@@ -0,0 +1,294 @@
+#include "database.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <minisql/connection.hpp>
+#include <minisql/options.hpp>
+
+#include "byte_io.hpp"
+#include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "headers.hpp"
+
+#include "unit_test_paths.hpp"
+#include "utils.hpp"
+
+using namespace minisql;
+
+namespace {
+
+// Return the first n bytes of the file at path.
+std::vector<std::byte> read_bytes(
+    const std::filesystem::path& path, std::size_t n
+) {
+    std::vector<std::byte> bytes(n);
+    std::ifstream file{path, std::ios::binary};
+    file.read(reinterpret_cast<char*>(bytes.data()), n);
+    assert(file);
+    return bytes;
+}
+
+// Overwrite the bytes of the file at path from offset with bytes.
+void write_bytes(
+    const std::filesystem::path& path, std::size_t offset,
+    const std::vector<std::byte>& bytes
+) {
+    std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+    file.seekp(offset);
+    file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    assert(file);
+}
+
+// Create a table at path holding the ints from 0 to n - 1.
+void fill(const std::filesystem::path& path, int n, const Options& options) {
+    Connection connection{path, options};
+    connection.exec("CREATE TABLE t (id INT, PRIMARY KEY(id));");
+    for (int i = 0; i < n; i++)
+        connection.exec("INSERT INTO t VALUES (" + std::to_string(i) + ");");
+}
+
+/* Return the sum of the ints in the first column of the rows returned by sql
+ * on the database at path. */
+int sum(
+    const std::filesystem::path& path, const Options& options = {},
+    std::string_view sql = "SELECT * FROM t;"
+) {
+    Connection connection{path, options};
+    int total = 0;
+    for (auto& row : connection.query(sql)) total += std::get<int>(row[0]);
+    return total;
+}
+
+} // namespace
+
+/* Tests:
+ * - a new file has the current magic number and format version, with its
+ *   pages after the space reserved for the header
+ * - a file with another format version is rejected with a FormatException */
+void test_format_version() {
+    std::filesystem::path path = make_temp_path();
+    fill(path, 100, {});
+    std::vector<std::byte> header = read_bytes(path, DatabaseHeader::SIZE);
+    assert(
+        byte_io::view<Magic>(header, DatabaseHeader::MAGIC_OFFSET) ==
+        Magic::DATABASE
+    );
+    assert(
+        byte_io::view<DatabaseHeader::format_version_t>(
+            header, DatabaseHeader::FORMAT_VERSION_OFFSET
+        ) == DatabaseHeader::FORMAT_VERSION
+    );
+    assert(
+        byte_io::view<DatabaseHeader::base_offset_t>(
+            header, DatabaseHeader::BASE_OFFSET_OFFSET
+        ) == DatabaseHeader::RESERVED_SIZE
+    );
+    assert(sum(path) == 4950);
+
+    byte_io::write<DatabaseHeader::format_version_t>(
+        header, DatabaseHeader::FORMAT_VERSION_OFFSET,
+        DatabaseHeader::FORMAT_VERSION + 1
+    );
+    write_bytes(path, 0, header);
+    bool thrown = false;
+    try { Connection connection{path}; }
+    catch (const FormatException&) { thrown = true; }
+    assert(thrown);
+    delete_path(path);
+    std::cout << "- test_format_version passed" << std::endl;
+}
+
+/* Tests:
+ * - a file with the unversioned magic number whose size does not match the
+ *   original format is rejected with a FormatException, and left as it was
+ *   without any partly rewritten file */
+void test_unversioned() {
+    std::filesystem::path path = make_temp_path();
+    fill(path, 100, {});
+    write_bytes(path, 0, {std::byte{0}});
+    const std::uintmax_t size = std::filesystem::file_size(path);
+    bool thrown = false;
+    try { Connection connection{path}; }
+    catch (const FormatException&) { thrown = true; }
+    assert(thrown);
+    assert(std::filesystem::file_size(path) == size);
+    std::filesystem::path temp_path = path;
+    temp_path += ".migrate";
+    assert(!std::filesystem::exists(temp_path));
+    delete_path(path);
+    std::cout << "- test_unversioned passed" << std::endl;
+}
+
+/* Tests:
+ * - a file created for direct I/O is read at the base offset in its header
+ *   whether or not it is reopened for direct I/O */
+void test_base_offset() {
+    std::filesystem::path path = make_temp_path();
+    Options options;
+    options.direct_io = true;
+    fill(path, 100, options);
+    assert(sum(path) == 4950);
+    assert(sum(path, options) == 4950);
+    delete_path(path);
+    std::cout << "- test_base_offset passed" << std::endl;
+}
+
+/* Tests:
+ * - a page size below DIRECT_IO_ALIGNMENT is rejected for direct I/O with a
+ *   PageSizeException, before a new file is created
+ * - an existing file with such pages can be opened, but not for direct I/O */
+void test_direct_io_page_size() {
+    std::filesystem::path path = make_temp_path();
+    Options options;
+    options.direct_io = true;
+    options.page_size = 1024;
+    bool thrown = false;
+    try { Connection connection{path, options}; }
+    catch (const PageSizeException&) { thrown = true; }
+    assert(thrown);
+    assert(!std::filesystem::exists(path));
+
+    options.direct_io = false;
+    fill(path, 100, options);
+    options.direct_io = true;
+    thrown = false;
+    try { Connection connection{path, options}; }
+    catch (const PageSizeException&) { thrown = true; }
+    assert(thrown);
+    assert(sum(path) == 4950);
+    delete_path(path);
+    std::cout << "- test_direct_io_page_size passed" << std::endl;
+}
+
+/* Tests, copying the file of a database while it is open to stand in for a
+ * crash, after a table is dropped and, if reclaim_pages is set, after some of
+ * its pages are freed by the statements that follow:
+ * - the copy no longer has the table, and the other table is intact
+ * - the pages of the dropped table are reclaimed, so that the table can be
+ *   filled again without growing the copy by more than the pages freed by
+ *   the last statement (and the reclaim list they replaced), which are only
+ *   marked free in the file by the next checkpoint
+ * - no page is freed twice, so both tables are intact */
+void test_reclaim_after_crash() {
+    for (const std::size_t reclaim_pages : {0, 4}) {
+        std::filesystem::path path = make_temp_path();
+        std::filesystem::path crash_path = make_temp_path();
+        Options options;
+        options.page_size = 1024;
+        options.reclaim_pages = reclaim_pages;
+        fill(path, 2000, options);
+        {
+            Connection connection{path, options};
+            connection.exec("CREATE TABLE u (id INT, PRIMARY KEY(id));");
+            for (int i = 0; i < 100; i++)
+                connection.exec(
+                    "INSERT INTO u VALUES (" + std::to_string(i) + ");"
+                );
+        }
+        {
+            Connection connection{path, options};
+            connection.exec("DROP TABLE t;");
+            for (int i = 0; i < 5; i++)
+                connection.exec("DELETE FROM u WHERE id < 0;");
+            std::filesystem::copy_file(path, crash_path);
+        }
+
+        bool thrown = false;
+        try { sum(crash_path); }
+        catch (const Exception&) { thrown = true; }
+        assert(thrown);
+        assert(sum(crash_path, options, "SELECT * FROM u;") == 4950);
+        const std::uintmax_t size = std::filesystem::file_size(crash_path);
+        {
+            Connection connection{crash_path, options};
+            connection.exec("VACUUM;");
+        }
+        fill(crash_path, 2000, options);
+        assert(
+            std::filesystem::file_size(crash_path) <=
+            size + (reclaim_pages + 1) * options.page_size
+        );
+        assert(sum(crash_path) == 1999000);
+        assert(sum(crash_path, options, "SELECT * FROM u;") == 4950);
+        delete_path(path);
+        delete_path(crash_path);
+    }
+    std::cout << "- test_reclaim_after_crash passed" << std::endl;
+}
+
+/* Tests, on legacy.db (written by the first release of Mini-SQL: a table
+ * "kept" with ids 0 to 199 and a dropped table, whose pages are on a
+ * FreeList):
+ * - the file is rewritten in the current format, and its rows can be read
+ * - the FreeList is emptied into the free-space map, which the header then
+ *   points to instead
+ * - the pages that were on the FreeList are reused, so that a new table of
+ *   about as many pages does not grow the file */
+void test_legacy() {
+    std::filesystem::path path = make_temp_path();
+    std::filesystem::copy_file(
+        std::filesystem::path{UNIT_TEST_ROOT} / "database" / "legacy.db", path
+    );
+    assert(
+        sum(path, {}, "SELECT id FROM kept WHERE score >= 50;") == 19900 - 4950
+    );
+    std::vector<std::byte> header = read_bytes(path, DatabaseHeader::SIZE);
+    assert(
+        byte_io::view<Magic>(header, DatabaseHeader::MAGIC_OFFSET) ==
+        Magic::DATABASE
+    );
+    assert(
+        byte_io::view<DatabaseHeader::page_size_t>(
+            header, DatabaseHeader::PAGE_SIZE_OFFSET
+        ) == LegacyDatabaseHeader::PAGE_SIZE
+    );
+    const page_id_t first_free_map_block = byte_io::view<page_id_t>(
+        header, DatabaseHeader::FIRST_FREE_MAP_BLOCK_OFFSET
+    );
+    assert(first_free_map_block != nullpid);
+    const std::size_t block_offset = DatabaseHeader::RESERVED_SIZE +
+        first_free_map_block * LegacyDatabaseHeader::PAGE_SIZE;
+    std::vector<std::byte> block = read_bytes(path, block_offset + 1);
+    assert(
+        byte_io::view<Magic>(block, block_offset) == Magic::FREE_MAP_BLOCK
+    );
+    std::filesystem::path temp_path = path;
+    temp_path += ".migrate";
+    assert(!std::filesystem::exists(temp_path));
+
+    const std::uintmax_t size = std::filesystem::file_size(path);
+    {
+        Connection connection{path};
+        connection.exec("CREATE TABLE t (id INT, pad TEXT(200));");
+        for (int i = 0; i < 50; i++)
+            connection.exec(
+                "INSERT INTO t VALUES (" + std::to_string(i) + ", \"x\");"
+            );
+    }
+    assert(std::filesystem::file_size(path) == size);
+    assert(sum(path) == 1225);
+    assert(sum(path, {}, "SELECT id FROM kept;") == 19900);
+    delete_path(path);
+    std::cout << "- test_legacy passed" << std::endl;
+}
+
+int main() {
+    test_format_version();
+    test_unversioned();
+    test_base_offset();
+    test_direct_io_page_size();
+    test_reclaim_after_crash();
+    test_legacy();
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
@@ -1,15 +1,30 @@
 #include "frame_manager/cache/cache.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <thread>
 #include <vector>
 
+#include "byte_io.hpp"
 #include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/cache/buffer_pool.hpp"
 #include "frame_manager/cache/frame_view.hpp"
+#include "frame_manager/cache/scan_ring.hpp"
+#include "frame_manager/cache/slab.hpp"
 #include "frame_manager/disk_manager/disk_manager.hpp"
+#include "frame_manager/disk_manager/file.hpp"
+#include "frame_manager/disk_manager/memory_file.hpp"
+#include "frame_manager/disk_manager/positional_file.hpp"
+#include "minisql/options.hpp"
+#include "platform.hpp"
 
 #include "utils.hpp"
 
@@ -102,10 +117,485 @@ void test_unpin() {
     std::cout << "- test_unpin passed" << std::endl;
 }
 
+/* Tests:
+ * - Frames are only set up once needed
+ * - Frames pinned before others are set up are unaffected
+ * - pinning more than max_capacity pages throws a CacheCapacityException
+ * - discarded pages are not written back */
+void test_grow() {
+    const std::size_t page_size = 2048;
+    MemoryFile file{page_size * 100};
+    DiskManager disk{file, 0, page_size, 0};
+    for (int i = 0; i < 100; i++) disk.extend();
+    {
+        Cache cache{disk, 20};
+        assert(cache.capacity() == 20);
+        assert(cache.max_capacity() == 20);
+        assert(cache.size() == 0);
+
+        std::vector<FrameView> fvs;
+        fvs.push_back(cache.pin(0));
+        fvs.back().write<int>(0, 7);
+        assert(cache.size() == 1);
+        for (page_id_t pid = 1; pid < 20; pid++) {
+            fvs.push_back(cache.pin(pid));
+            fvs.back().write<int>(0, pid);
+        }
+        assert(cache.size() == 20);
+        assert(fvs.front().view<int>(0) == 7);
+
+        try {
+            cache.pin(20);
+            assert(false);
+        }
+        catch (const CacheCapacityException&) {}
+
+        fvs.clear();
+        cache.discard();
+    }
+    assert(file.allocated() == 0);
+    std::cout << "- test_grow passed" << std::endl;
+}
+
+/* Tests:
+ * - capacity is clamped to between 1 and max_capacity
+ * - growing lets more pages stay in the cache
+ * - shrinking evicts unpinned pages and writes back dirty ones
+ * - shrinking below the number of pinned pages does not throw, and the extra
+ *   pages are evicted once unpinned
+ * - pinning beyond capacity uses spare Frames rather than throwing */
+void test_resize() {
+    const std::size_t page_size = 2048;
+    MemoryFile file{page_size * 100};
+    DiskManager disk{file, 0, page_size, 0};
+    for (int i = 0; i < 100; i++) disk.extend();
+    Cache cache{disk, 10, 50};
+    assert(cache.resize(0) == 1);
+    assert(cache.resize(1000) == 50);
+
+    for (page_id_t pid = 0; pid < 50; pid++)
+        cache.pin(pid).write<page_id_t>(0, pid + 1);
+    assert(cache.size() == 50);
+
+    assert(cache.resize(10) == 10);
+    assert(cache.size() == 10);
+    std::vector<std::byte> dst(page_size);
+    for (page_id_t pid = 0; pid < 50; pid++) {
+        disk.read(pid, dst.data());
+        const page_id_t expected = byte_io::view<page_id_t>(dst, 0);
+        assert(expected == pid + 1 || expected == 0);
+        assert(cache.pin(pid).view<page_id_t>(0) == pid + 1);
+    }
+    assert(cache.size() == 10);
+
+    {
+        std::vector<FrameView> fvs;
+        for (page_id_t pid = 0; pid < 20; pid++) fvs.push_back(cache.pin(pid));
+        assert(cache.size() == 20);
+        assert(cache.resize(5) == 5);
+        assert(cache.size() == 20);
+        fvs.push_back(cache.pin(20));
+        assert(cache.size() == 21);
+    }
+    cache.pin(21);
+    assert(cache.size() == 5);
+    std::cout << "- test_resize passed" << std::endl;
+}
+
+/* Tests:
+ * - Caches sharing a BufferPool evict each other's pages within its capacity
+ * - pages evicted by another Cache are written back to their own disk
+ * - the same page_id_t in different Caches refers to different pages
+ * - hits and misses are counted per Cache
+ * - a Cache with a different page size to the pool is rejected
+ * - destroying a Cache frees its Frames in the pool */
+void test_shared_pool() {
+    const std::size_t page_size = 2048;
+    MemoryFile file_a{page_size * 50}, file_b{page_size * 50};
+    DiskManager disk_a{file_a, 0, page_size, 0};
+    DiskManager disk_b{file_b, 0, page_size, 0};
+    for (int i = 0; i < 50; i++) {
+        disk_a.extend();
+        disk_b.extend();
+    }
+    auto pool = std::make_shared<BufferPool>(page_size, 10);
+    {
+        Cache cache_a{disk_a, pool}, cache_b{disk_b, pool};
+        for (page_id_t pid = 0; pid < 10; pid++)
+            cache_a.pin(pid).write<page_id_t>(0, pid + 1);
+        assert(cache_a.size() == 10 && pool->size() == 10);
+
+        for (page_id_t pid = 0; pid < 10; pid++)
+            cache_b.pin(pid).write<page_id_t>(0, pid + 100);
+        assert(cache_a.size() == 0 && cache_b.size() == 10);
+        assert(pool->size() == 10);
+
+        std::vector<std::byte> dst(page_size);
+        for (page_id_t pid = 0; pid < 10; pid++) {
+            disk_a.read(pid, dst.data());
+            assert(byte_io::view<page_id_t>(dst, 0) == pid + 1);
+        }
+        for (page_id_t pid = 0; pid < 5; pid++)
+            assert(cache_b.pin(pid).view<page_id_t>(0) == pid + 100);
+        for (page_id_t pid = 0; pid < 5; pid++)
+            assert(cache_a.pin(pid).view<page_id_t>(0) == pid + 1);
+        assert(cache_a.stats().hits == 0 && cache_a.stats().misses == 15);
+        assert(cache_b.stats().hits == 5 && cache_b.stats().misses == 10);
+
+        MemoryFile file_c{page_size * 2};
+        DiskManager disk_c{file_c, 0, page_size * 2, 0};
+        try {
+            Cache cache_c{disk_c, pool};
+            assert(false);
+        }
+        catch (const CacheException&) {}
+    }
+    assert(pool->size() == 0);
+    std::cout << "- test_shared_pool passed" << std::endl;
+}
+
+/* Tests:
+ * - a BufferPool only has a background writer given a dirty_ratio
+ * - once more than dirty_ratio of the pool is dirty, the writer writes pages
+ *   back until at most half that is
+ * - pages written by the writer hold their latest contents on disk
+ * - pages evicted or flushed after the writer has run are still intact */
+void test_background_writer() {
+    const std::size_t page_size = 2048;
+    MemoryFile file{page_size * 40};
+    DiskManager disk{file, 0, page_size, 0};
+    for (int i = 0; i < 40; i++) disk.extend();
+    assert(!BufferPool(page_size, 20).background_writer());
+
+    auto pool = std::make_shared<BufferPool>(
+        page_size, 20, 0, CachePolicy::CLOCK, false, 0.25
+    );
+    assert(pool->background_writer());
+    {
+        Cache cache{disk, pool};
+        for (page_id_t pid = 0; pid < 5; pid++)
+            cache.pin(pid).write<page_id_t>(0, pid + 1);
+        assert(pool->dirty() == 5);
+        cache.pin(5).write<page_id_t>(0, 6);
+
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds{10};
+        while (pool->dirty() > 2) {
+            assert(std::chrono::steady_clock::now() < deadline);
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        std::vector<std::byte> dst(page_size);
+        std::size_t written = 0;
+        for (page_id_t pid = 0; pid < 6; pid++) {
+            disk.read(pid, dst.data());
+            written += byte_io::view<page_id_t>(dst, 0) == pid + 1;
+        }
+        assert(written >= 4);
+
+        for (page_id_t pid = 0; pid < 10; pid++)
+            cache.pin(pid).write<page_id_t>(0, pid + 100);
+        for (page_id_t pid = 20; pid < 40; pid++) cache.pin(pid);
+        for (page_id_t pid = 0; pid < 10; pid++)
+            assert(cache.pin(pid).view<page_id_t>(0) == pid + 100);
+        for (page_id_t pid = 0; pid < 5; pid++)
+            cache.pin(pid).write<page_id_t>(0, pid + 200);
+        cache.flush_all();
+        assert(pool->dirty() == 0);
+        for (page_id_t pid = 0; pid < 10; pid++) {
+            disk.read(pid, dst.data());
+            assert(
+                byte_io::view<page_id_t>(dst, 0) == pid + (pid < 5 ? 200 : 100)
+            );
+        }
+    }
+    std::cout << "- test_background_writer passed" << std::endl;
+}
+
+/* Tests:
+ * - an empty Slab allocates nothing
+ * - a Slab is aligned for direct I/O, or to a huge page if using them
+ * - every byte of a Slab can be written
+ * - the buffers of a Cache are consecutive slices of its Slab */
+void test_slab() {
+    {
+        Slab slab{0};
+        assert(!slab.data());
+    }
+    for (bool huge_pages : {false, true}) {
+        const std::size_t size = 3 * 1024 * 1024 + 4096;
+        Slab slab{size, huge_pages};
+        const auto address = reinterpret_cast<std::uintptr_t>(slab.data());
+        assert(address % DIRECT_IO_ALIGNMENT == 0);
+        if (slab.huge_pages()) assert(address % (2 * 1024 * 1024) == 0);
+        std::memset(slab.data(), 0xff, slab.size());
+    }
+
+    const std::size_t page_size = 2048;
+    MemoryFile file{page_size * 10};
+    DiskManager disk{file, 0, page_size, 0};
+    for (int i = 0; i < 10; i++) disk.extend();
+    Cache cache{disk, 10, 0, CachePolicy::CLOCK, true};
+    std::vector<FrameView> fvs;
+    for (page_id_t pid = 0; pid < 10; pid++) fvs.push_back(cache.pin(pid));
+    std::sort(fvs.begin(), fvs.end(),
+        [](const FrameView& a, const FrameView& b) {
+            return a.data() < b.data();
+        }
+    );
+    for (std::size_t i = 1; i < fvs.size(); i++)
+        assert(fvs[i].data() == fvs[i - 1].data() + page_size);
+    std::cout << "- test_slab passed" << std::endl;
+}
+
+/* Tests:
+ * - kept pages stay cached however many other pages are pinned
+ * - no more than a quarter of the capacity is kept
+ * - kept pages are listed first by hot_pages
+ * - a page no longer kept is evicted like any other
+ * - destroying a Cache stops keeping its pages */
+void test_keep() {
+    const std::size_t page_size = 2048;
+    MemoryFile file{page_size * 40};
+    DiskManager disk{file, 0, page_size, 0};
+    for (int i = 0; i < 40; i++) disk.extend();
+    auto pool = std::make_shared<BufferPool>(page_size, 20);
+    {
+        Cache cache{disk, pool};
+        for (page_id_t pid = 0; pid < 6; pid++) cache.pin(pid).keep();
+        assert(pool->kept() == 5);
+        for (page_id_t pid = 10; pid < 40; pid++) cache.pin(pid);
+
+        const std::uint64_t misses = cache.stats().misses;
+        for (page_id_t pid = 0; pid < 5; pid++) cache.pin(pid);
+        assert(cache.stats().misses == misses);
+        cache.pin(5);
+        assert(cache.stats().misses == misses + 1);
+
+        std::vector<page_id_t> hot = cache.hot_pages();
+        std::sort(hot.begin(), hot.begin() + 5);
+        for (page_id_t pid = 0; pid < 5; pid++) assert(hot[pid] == pid);
+
+        cache.unkeep(2);
+        assert(pool->kept() == 4);
+        for (page_id_t pid = 10; pid < 40; pid++) cache.pin(pid);
+        cache.pin(2);
+        assert(cache.stats().misses == misses + 2 + 30);
+    }
+    assert(pool->kept() == 0);
+    std::cout << "- test_keep passed" << std::endl;
+}
+
+/* Tests:
+ * - dropped pages give up their Frames without being written back, even if
+ *   kept
+ * - a pinned page is only no longer kept */
+void test_drop() {
+    const std::size_t page_size = 2048;
+    MemoryFile file{page_size * 10};
+    DiskManager disk{file, 0, page_size, 0};
+    for (int i = 0; i < 10; i++) disk.extend();
+    Cache cache{disk, 10};
+    for (page_id_t pid = 0; pid < 6; pid++)
+        cache.pin(pid).write<page_id_t>(0, pid + 1);
+    cache.pin(1).keep();
+    {
+        FrameView pinned = cache.pin(5);
+        pinned.keep();
+        assert(cache.pool()->kept() == 2);
+        std::vector<page_id_t> pids{1, 2, 5, 8};
+        cache.drop(pids);
+        assert(cache.size() == 4 && cache.pool()->kept() == 0);
+        assert(cache.pool()->dirty() == 4);
+    }
+    cache.flush_all();
+    std::vector<std::byte> dst(page_size);
+    for (page_id_t pid = 0; pid < 6; pid++) {
+        disk.read(pid, dst.data());
+        const bool dropped = pid == 1 || pid == 2;
+        assert(byte_io::view<page_id_t>(dst, 0) == (dropped ? 0 : pid + 1));
+    }
+    std::cout << "- test_drop passed" << std::endl;
+}
+
+/* Tests:
+ * - pages missed through a ScanRing recycle its Frames, leaving the rest of
+ *   the cache alone
+ * - dirty pages are written back as the ring reuses their Frames
+ * - pages already cached are pinned in place through a ring
+ * - a page pinned without the ring is no longer reused by it */
+void test_scan_ring() {
+    const std::size_t page_size = 2048;
+    MemoryFile file{page_size * 100};
+    DiskManager disk{file, 0, page_size, 0};
+    for (int i = 0; i < 100; i++) disk.extend();
+    Cache cache{disk, 20};
+    for (page_id_t pid = 0; pid < 10; pid++) cache.pin(pid);
+
+    ScanRing ring{4};
+    for (page_id_t pid = 20; pid < 100; pid++)
+        cache.pin(pid, &ring).write<page_id_t>(0, pid + 1);
+    assert(cache.size() == 14);
+    assert(cache.pool()->dirty() == 4);
+    std::vector<std::byte> dst(page_size);
+    for (page_id_t pid = 20; pid < 96; pid++) {
+        disk.read(pid, dst.data());
+        assert(byte_io::view<page_id_t>(dst, 0) == pid + 1);
+    }
+
+    const std::uint64_t misses = cache.stats().misses;
+    cache.pin(5, &ring);
+    for (page_id_t pid = 0; pid < 10; pid++) cache.pin(pid);
+    assert(cache.stats().misses == misses);
+
+    assert(cache.pin(96).view<page_id_t>(0) == 97);
+    for (page_id_t pid = 40; pid < 44; pid++) cache.pin(pid, &ring);
+    assert(cache.size() == 15);
+    assert(cache.pool()->dirty() == 1);
+    assert(cache.pin(96).view<page_id_t>(0) == 97);
+    assert(cache.stats().misses == misses + 4);
+    std::cout << "- test_scan_ring passed" << std::endl;
+}
+
+#ifdef MINISQL_POSIX
+/* Tests:
+ * - runs of adjacent dirty pages are each flushed with one syscall
+ * - flushed pages are written in place
+ * - flushing with no dirty pages does nothing */
+void test_flush_all() {
+    std::filesystem::path path = make_temp_path();
+    create_file(path);
+    {
+        PositionalFile file{path};
+        DiskManager disk{file, 0, 2048, 0};
+        for (int i = 0; i < 100; i++) disk.extend();
+        Cache cache{disk, 100};
+
+        for (page_id_t pid : {50, 3, 1, 2, 51, 90, 0, 52})
+            cache.pin(pid).write<page_id_t>(0, pid + 1);
+        WriteStats stats = cache.flush_all();
+        assert(stats.syscalls == 3);
+        assert(stats.bytes == 8 * disk.page_size());
+
+        std::vector<std::byte> dst(disk.page_size());
+        for (page_id_t pid : {0, 1, 2, 3, 50, 51, 52, 90}) {
+            disk.read(pid, dst.data());
+            assert(byte_io::view<page_id_t>(dst, 0) == pid + 1);
+        }
+        disk.read(4, dst.data());
+        assert(byte_io::view<page_id_t>(dst, 0) == 0);
+
+        stats = cache.flush_all();
+        assert(!stats.syscalls && !stats.bytes);
+    }
+    delete_path(path);
+    std::cout << "- test_flush_all passed" << std::endl;
+}
+
+/* Tests:
+ * - prefetched pages are read correctly once pinned
+ * - dirty pages evicted by a prefetch are written back
+ * - prefetching stops once every Frame is pinned or in the batch
+ * - prefetched pages count as hits once pinned and as misses if evicted
+ *   first */
+void test_prefetch() {
+    std::filesystem::path path = make_temp_path();
+    create_file(path);
+    {
+        PositionalFile file{path};
+        DiskManager disk{file, 0, 2048, 0, false, true};
+        const std::size_t capacity = 100;
+        for (std::size_t i = 0; i < capacity * 3; i++) disk.extend();
+        Cache cache{disk, capacity};
+
+        for (page_id_t pid = 0; pid < capacity; pid++)
+            cache.pin(pid).write<page_id_t>(0, pid);
+
+        std::vector<page_id_t> pids;
+        for (page_id_t pid = capacity; pid < capacity * 3; pid++)
+            pids.push_back(pid);
+        cache.prefetch(pids);
+        assert(cache.prefetch_stats().pages == capacity);
+        for (page_id_t pid = capacity; pid < capacity * 2; pid++)
+            assert(cache.pin(pid).view<page_id_t>(0) == 0);
+        assert(cache.prefetch_stats().hits == capacity);
+        for (page_id_t pid = 0; pid < capacity; pid++)
+            assert(cache.pin(pid).view<page_id_t>(0) == pid);
+        assert(cache.prefetch_stats().misses == 0);
+
+        {
+            FrameView fv = cache.pin(0);
+            cache.prefetch(pids);
+            assert(fv.view<page_id_t>(0) == 0);
+        }
+        const std::size_t prefetched =
+            cache.prefetch_stats().pages - capacity;
+        for (page_id_t pid = capacity * 2; pid < capacity * 3; pid++)
+            cache.pin(pid);
+        assert(cache.prefetch_stats().hits == capacity);
+        assert(cache.prefetch_stats().misses == prefetched);
+        cache.flush_all();
+        std::vector<std::byte> dst(disk.page_size());
+        disk.read(capacity - 1, dst.data());
+        assert(byte_io::view<page_id_t>(dst, 0) == capacity - 1);
+    }
+    delete_path(path);
+    std::cout << "- test_prefetch passed" << std::endl;
+}
+
+/* Tests:
+ * - pinning a clean page from the mapping
+ * - writing to a mapped page does not modify the file until flushed
+ * - pinning pages after the mapping has grown */
+void test_mapped() {
+    std::filesystem::path path = make_temp_path();
+    create_file(path);
+    {
+        PositionalFile file{path};
+        DiskManager disk{file, 0, 2048, 0, true};
+        assert(disk.mapped());
+        disk.extend();
+        Cache cache{disk, 10};
+        {
+            FrameView fv = cache.pin(0);
+            assert(fv.data() == disk.map(0));
+            fv.write<int>(0, 1);
+            assert(fv.data() != disk.map(0));
+            assert(fv.view<int>(0) == 1);
+            int on_disk;
+            std::memcpy(&on_disk, disk.map(0), sizeof(int));
+            assert(on_disk == 0);
+        }
+        cache.flush_all();
+        int on_disk;
+        std::memcpy(&on_disk, disk.map(0), sizeof(int));
+        assert(on_disk == 1);
+
+        for (page_id_t pid = 1; pid < 1000; pid++) disk.extend();
+        for (page_id_t pid = 0; pid < disk.page_count(); pid++)
+            assert(cache.pin(pid).view<int>(0) == (pid ? 0 : 1));
+    }
+    delete_path(path);
+    std::cout << "- test_mapped passed" << std::endl;
+}
+#endif
+
 int main() {
     test_constructor();
     test_pin();
     test_unpin();
+    test_grow();
+    test_resize();
+    test_shared_pool();
+    test_background_writer();
+    test_slab();
+    test_keep();
+    test_drop();
+    test_scan_ring();
+#ifdef MINISQL_POSIX
+    test_flush_all();
+    test_prefetch();
+    test_mapped();
+#endif
     std::cout << "All tests passed." << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -1,39 +1,67 @@
 #include "frame_manager/disk_manager/disk_manager.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "byte_io.hpp"
 #include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/cache/cache.hpp"
+#include "frame_manager/cache/frame_view.hpp"
+#include "frame_manager/disk_manager/file.hpp"
+#include "frame_manager/disk_manager/memory_file.hpp"
 #include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/disk_manager/positional_file.hpp"
+#include "headers.hpp"
+#include "platform.hpp"
 
 #include "utils.hpp"
 
 using namespace minisql;
 
-void test_constructor() {
+namespace {
+
+// A MemoryFile that counts the bytes read from it.
+class CountingFile : public MemoryFile {
+public:
+    using MemoryFile::MemoryFile;
+
+    void read(std::streamoff offset, std::byte* dst, std::size_t size)
+        override {
+        bytes_read += size;
+        MemoryFile::read(offset, dst, size);
+    }
+
+    std::size_t bytes_read {0};
+};
+
+} // namespace
+
+void test_constructor(FileBackend backend) {
     std::filesystem::path path = make_temp_path();
     const std::streamoff base_offset = 32;
     const std::size_t page_size = 4096;
     const page_id_t page_count = 100;
     create_file(path, base_offset + page_size * page_count);
-    std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+    std::unique_ptr<File> file = open_file(path, backend);
     {
-        DiskManager disk{file, base_offset, page_size, page_count};
+        DiskManager disk{*file, base_offset, page_size, page_count};
         assert(disk.page_size() == page_size);
         assert(disk.page_count() == page_count);
     }
     try {
-        DiskManager disk{file, base_offset - 1, page_size, page_count};
+        DiskManager disk{*file, base_offset - 1, page_size, page_count};
         assert(false);
     }
     catch (const DiskException&) {}
     try {
-        DiskManager disk{file, base_offset + 1, page_size, page_count};
+        DiskManager disk{*file, base_offset + 1, page_size, page_count};
         assert(false);
     }
     catch (const DiskException&) {}
@@ -41,12 +69,12 @@ void test_constructor() {
     std::cout << "- test_constructor passed" << std::endl;
 }
 
-void test_extend() {
+void test_extend(FileBackend backend) {
     std::filesystem::path path = make_temp_path();
     create_file(path);
-    std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+    std::unique_ptr<File> file = open_file(path, backend);
     {
-        DiskManager disk{file, 0, 4096, 0};
+        DiskManager disk{*file, 0, 4096, 0};
         for (int i = 0; i < 100; i++) {
             assert(disk.page_count() == i);
             disk.extend();
@@ -56,13 +84,13 @@ void test_extend() {
     std::cout << "- test_extend passed" << std::endl;
 }
 
-void test_write_read() {
+void test_write_read(FileBackend backend) {
     std::filesystem::path path = make_temp_path();
     const std::size_t page_size = 4096;
     create_file(path);
-    std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+    std::unique_ptr<File> file = open_file(path, backend);
     {
-        DiskManager disk{file, 0, page_size, 0};
+        DiskManager disk{*file, 0, page_size, 0};
         disk.extend();
         std::vector<std::byte> src(page_size);
         std::size_t i = 0;
@@ -92,10 +120,367 @@ void test_write_read() {
     std::cout << "- test_write_read passed" << std::endl;
 }
 
+/* Tests:
+ * - pages of a MemoryFile read as zeros until written
+ * - storage is only allocated for written blocks
+ * - growing beyond the limit throws a MemoryLimitException */
+void test_memory_file() {
+    const std::size_t page_size = 4096;
+    MemoryFile file{page_size * 4};
+    DiskManager disk{file, 0, page_size, 0};
+    for (int i = 0; i < 4; i++) disk.extend();
+    assert(file.size() == page_size * 4);
+    assert(file.allocated() == 0);
+
+    std::vector<std::byte> page(page_size);
+    disk.read(2, page.data());
+    assert(std::all_of(page.begin(), page.end(),
+        [](std::byte b) { return b == std::byte{0}; }));
+
+    byte_io::write<std::int32_t>(page, 0, 1234);
+    byte_io::write<std::int32_t>(page, page_size - 4, 5678);
+    disk.write(2, page.data());
+    assert(file.allocated() == page_size);
+    std::vector<std::byte> read_back(page_size);
+    disk.read(2, read_back.data());
+    assert(read_back == page);
+
+    try {
+        disk.extend();
+        assert(false);
+    }
+    catch (const MemoryLimitException&) {}
+    assert(disk.page_count() == 4);
+    std::cout << "- test_memory_file passed" << std::endl;
+}
+
+#ifdef MINISQL_POSIX
+void test_positional_file() {
+    std::filesystem::path path = make_temp_path();
+    const std::streamoff base_offset = 32;
+    const std::size_t page_size = 4096;
+    const page_id_t page_count = 10;
+    create_file(path, base_offset + page_size * page_count);
+    {
+        PositionalFile file{path};
+        try {
+            DiskManager disk{file, base_offset + 1, page_size, page_count};
+            assert(false);
+        }
+        catch (const DiskException&) {}
+
+        DiskManager disk{file, base_offset, page_size, page_count};
+        disk.extend();
+        assert(disk.page_count() == page_count + 1);
+        assert(file.size() == base_offset + page_size * (page_count + 1));
+
+        std::vector<std::byte> src(page_size);
+        for (std::size_t i = 0; i < page_size; i++)
+            src[i] = static_cast<std::byte>(i);
+        for (page_id_t pid = 0; pid < disk.page_count(); pid++) {
+            src[0] = static_cast<std::byte>(pid);
+            disk.write(pid, src.data());
+        }
+        std::vector<std::byte> dst(page_size);
+        for (page_id_t pid = 0; pid < disk.page_count(); pid++) {
+            disk.read(pid, dst.data());
+            src[0] = static_cast<std::byte>(pid);
+            assert(src == dst);
+        }
+        try {
+            disk.read(disk.page_count(), dst.data());
+            assert(false);
+        }
+        catch (const DiskException&) {}
+    }
+    delete_path(path);
+    std::cout << "- test_positional_file passed" << std::endl;
+}
+
+/* Tests, on a PositionalFile:
+ * - a write past the end grows the file, and the gap reads as zeros
+ * - resize grows the file with zeros and shrinks it
+ * - a read running past the end throws a FileIOException at the offset it
+ *   stopped at, as does one starting past the end
+ * - a vectored write of several buffers is a single syscall */
+void test_positional_transfers() {
+    std::filesystem::path path = make_temp_path();
+    {
+        PositionalFile file{path};
+        assert(file.size() == 0);
+        const std::vector<std::byte> src(100, std::byte{5});
+        file.write(50, src.data(), src.size());
+        assert(file.size() == 150);
+        std::vector<std::byte> dst(150, std::byte{1});
+        file.read(0, dst.data(), dst.size());
+        assert(std::all_of(dst.begin(), dst.begin() + 50,
+            [](std::byte b) { return b == std::byte{0}; }));
+        assert(std::equal(src.begin(), src.end(), dst.begin() + 50));
+
+        file.resize(300);
+        assert(file.size() == 300);
+        file.read(150, dst.data(), 150);
+        assert(dst == std::vector<std::byte>(150));
+        file.resize(100);
+        assert(file.size() == 100);
+
+        try {
+            file.read(50, dst.data(), 100);
+            assert(false);
+        }
+        catch (const FileIOException& e) {
+            assert(std::string{e.what()}.find("offset 100 ") !=
+                std::string::npos);
+        }
+        try {
+            file.read(200, dst.data(), 1);
+            assert(false);
+        }
+        catch (const FileIOException&) {}
+
+        std::vector<const std::byte*> srcs(3, src.data());
+        assert(file.writev(100, srcs, src.size()) == 1);
+        assert(file.size() == 400);
+        file.read(100, dst.data(), 100);
+        assert(std::equal(src.begin(), src.end(), dst.begin()));
+    }
+    delete_path(path);
+    std::cout << "- test_positional_transfers passed" << std::endl;
+}
+
+/* Tests:
+ * - the file size matches page_count while growing through several extents
+ * - extended pages read back as zeros
+ * - the file can be reopened with the final page_count */
+void test_extent() {
+    std::filesystem::path path = make_temp_path();
+    const std::size_t page_size = 4096;
+    const page_id_t extent_pages = 16;
+    create_file(path);
+    {
+        PositionalFile file{path};
+        {
+            DiskManager disk{file, 0, page_size, 0, false, false, extent_pages};
+            std::vector<std::byte> src(page_size, std::byte{1});
+            for (page_id_t pid = 0; pid < extent_pages * 3 + 1; pid++) {
+                disk.extend();
+                assert(file.size() == page_size * disk.page_count());
+                disk.write(pid, src.data());
+            }
+            disk.extend();
+            std::vector<std::byte> dst(page_size, std::byte{1});
+            disk.read(disk.page_count() - 1, dst.data());
+            assert(dst == std::vector<std::byte>(page_size));
+        }
+        DiskManager disk{file, 0, page_size, extent_pages * 3 + 2};
+    }
+    delete_path(path);
+    std::cout << "- test_extent passed" << std::endl;
+}
+
+/* Tests:
+ * - aligned and unaligned transfers on a file opened for direct I/O
+ * - unaligned writes do not change the size of the file beyond their end
+ * - vectored writes of aligned pages */
+void test_direct() {
+    std::filesystem::path path = make_temp_path();
+    const std::size_t page_size = 4096;
+    create_file(path, 13);
+    {
+        PositionalFile file{path, true};
+        assert(!file.map(page_size));
+        DiskManager disk{file, 13, page_size, 0};
+        for (int i = 0; i < 4; i++) disk.extend();
+        std::vector<std::byte> src(page_size, std::byte{7});
+        disk.write(1, src.data());
+        std::vector<std::byte> dst(page_size);
+        disk.read(1, dst.data());
+        assert(src == dst);
+        assert(file.size() == 13 + page_size * 4);
+
+        std::vector<std::byte> header(13, std::byte{1});
+        file.write(0, header.data(), header.size());
+        assert(file.size() == 13 + page_size * 4);
+        disk.read(0, dst.data());
+        assert(dst == std::vector<std::byte>(page_size));
+    }
+    delete_path(path);
+
+    create_file(path, page_size);
+    {
+        PositionalFile file{path, true};
+        DiskManager disk{file, page_size, page_size, 0};
+        for (int i = 0; i < 8; i++) disk.extend();
+        Cache cache{disk, 8};
+        for (page_id_t pid = 0; pid < 8; pid++) {
+            FrameView fv = cache.pin(pid);
+            assert(!(reinterpret_cast<std::uintptr_t>(fv.data()) %
+                DIRECT_IO_ALIGNMENT));
+            fv.write<page_id_t>(0, pid + 1);
+        }
+        WriteStats stats = cache.flush_all();
+        if (file.direct()) assert(stats.syscalls == 1);
+        std::vector<std::byte> dst(page_size);
+        for (page_id_t pid = 0; pid < 8; pid++) {
+            disk.read(pid, dst.data());
+            assert(byte_io::view<page_id_t>(dst, 0) == pid + 1);
+        }
+    }
+    delete_path(path);
+    std::cout << "- test_direct passed" << std::endl;
+}
+
+/* Tests:
+ * - leaf pages are compressed and read back intact, other pages are not
+ * - compressed pages are decompressed after asynchronous reads
+ * - compressed pages are not served from the mapping
+ * - the counters track pages and bytes */
+void test_compression() {
+    std::filesystem::path path = make_temp_path();
+    const std::size_t page_size = 4096;
+    create_file(path);
+    {
+        PositionalFile file{path};
+        DiskManager disk{file, 0, page_size, 0, true, true, 16, true};
+        for (int i = 0; i < 4; i++) disk.extend();
+
+        std::vector<std::byte> leaf(page_size);
+        byte_io::write<Magic>(leaf, 0, Magic::LEAF_NODE);
+        for (std::size_t i = 64; i < page_size; i += 256)
+            leaf[i] = static_cast<std::byte>(i / 256);
+        std::vector<std::byte> internal = leaf;
+        byte_io::write<Magic>(internal, 0, Magic::INTERNAL_NODE);
+        disk.write(0, leaf.data());
+        disk.write(1, internal.data());
+
+        CompressionStats stats = disk.compression_stats();
+        assert(stats.pages_compressed == 1);
+        assert(stats.page_bytes == page_size);
+        assert(stats.stored_bytes < page_size);
+
+        std::vector<std::byte> raw(page_size);
+        file.read(0, raw.data(), page_size);
+        assert(byte_io::view<Magic>(raw, 0) == Magic::COMPRESSED_PAGE);
+        assert(!disk.map(0));
+        assert(disk.map(1));
+
+        std::vector<std::byte> dst(page_size);
+        disk.read(0, dst.data());
+        assert(dst == leaf);
+        disk.read(1, dst.data());
+        assert(dst == internal);
+        stats = disk.compression_stats();
+        assert(stats.pages_decompressed == 1);
+
+        std::vector<PageBuffer> pages {{0, dst.data()}};
+        std::fill(dst.begin(), dst.end(), std::byte{0});
+        disk.read_async(pages);
+        disk.wait();
+        assert(dst == leaf);
+    }
+    delete_path(path);
+    std::cout << "- test_compression passed" << std::endl;
+}
+
+/* Tests:
+ * - reading a compressed page transfers only its stored part
+ * - reading an uncompressed page transfers the whole page */
+void test_compressed_read() {
+    const std::size_t page_size = 4096;
+    CountingFile file{page_size * 2};
+    DiskManager disk{file, 0, page_size, 0, false, false, 1, true};
+    for (int i = 0; i < 2; i++) disk.extend();
+
+    std::vector<std::byte> leaf(page_size);
+    byte_io::write<Magic>(leaf, 0, Magic::LEAF_NODE);
+    std::vector<std::byte> internal = leaf;
+    byte_io::write<Magic>(internal, 0, Magic::INTERNAL_NODE);
+    disk.write(0, leaf.data());
+    disk.write(1, internal.data());
+    const std::size_t stored = disk.compression_stats().stored_bytes;
+    assert(stored && stored < page_size);
+
+    std::vector<std::byte> dst(page_size);
+    disk.read(0, dst.data());
+    assert(dst == leaf);
+    assert(file.bytes_read == stored);
+    file.bytes_read = 0;
+    disk.read(1, dst.data());
+    assert(dst == internal);
+    assert(file.bytes_read == page_size);
+    std::cout << "- test_compressed_read passed" << std::endl;
+}
+
+/* Tests:
+ * - batched writes then reads with and without io_uring
+ * - batches larger than the ring
+ * - submitting a page beyond the end of the file */
+void test_async() {
+    const std::size_t page_size = 4096;
+    const page_id_t page_count = 200;
+    for (bool async_io : {false, true}) {
+        std::filesystem::path path = make_temp_path();
+        create_file(path, page_size * page_count);
+        {
+            PositionalFile file{path};
+            DiskManager disk{file, 0, page_size, page_count, false, async_io};
+            if (!async_io) assert(!disk.async());
+
+            std::vector<std::vector<std::byte>> buffers(
+                page_count, std::vector<std::byte>(page_size)
+            );
+            std::vector<PageBuffer> pages;
+            for (page_id_t pid = 0; pid < page_count; pid++) {
+                buffers[pid][0] = static_cast<std::byte>(pid);
+                buffers[pid][page_size - 1] = static_cast<std::byte>(~pid);
+                pages.push_back({pid, buffers[pid].data()});
+            }
+            disk.write_async(pages);
+            disk.wait();
+
+            for (auto& buffer : buffers)
+                std::fill(buffer.begin(), buffer.end(), std::byte{0});
+            disk.read_async(pages);
+            disk.wait();
+            for (page_id_t pid = 0; pid < page_count; pid++) {
+                assert(buffers[pid][0] == static_cast<std::byte>(pid));
+                assert(buffers[pid][page_size - 1] ==
+                    static_cast<std::byte>(~pid));
+            }
+
+            std::vector<std::byte> dst(page_size);
+            disk.read(page_count - 1, dst.data());
+            assert(dst == buffers[page_count - 1]);
+
+            std::vector<PageBuffer> beyond {{page_count, dst.data()}};
+            try {
+                disk.read_async(beyond);
+                assert(false);
+            }
+            catch (const DiskException&) {}
+        }
+        delete_path(path);
+    }
+    std::cout << "- test_async passed" << std::endl;
+}
+#endif
+
 int main() {
-    test_constructor();
-    test_extend();
-    test_write_read();
+    for (FileBackend backend : {FileBackend::STREAM, FileBackend::POSITIONAL}) {
+        test_constructor(backend);
+        test_extend(backend);
+        test_write_read(backend);
+    }
+    test_memory_file();
+#ifdef MINISQL_POSIX
+    test_positional_file();
+    test_positional_transfers();
+    test_extent();
+    test_direct();
+    test_compression();
+    test_compressed_read();
+    test_async();
+#endif
     std::cout << "All tests passed." << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -1,14 +1,18 @@
 #include "frame_manager/free_list/free_list.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <vector>
 
 #include "frame_manager/cache/cache.hpp"
 #include "frame_manager/disk_manager/disk_manager.hpp"
+#include "frame_manager/disk_manager/memory_file.hpp"
 #include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/free_list/free_list_block.hpp"
 #include "headers.hpp"
 
 #include "utils.hpp"
@@ -59,9 +63,64 @@ void test_push_pop() {
     std::cout << "- test_push_pop passed" << std::endl;
 }
 
+/* Tests:
+ * - pushing and popping pin at most two pages each, however long the list
+ * - a list whose first block is its oldest (as once written) is popped whole,
+ *   each page_id_t and block page exactly once */
+void test_chain() {
+    const std::size_t page_size = 1024;
+    const std::size_t pids_per_block =
+        (page_size - FreeListBlockHeader::SIZE) / sizeof(page_id_t);
+    const page_id_t page_count = pids_per_block * 20;
+    MemoryFile file{page_size * page_count};
+    DiskManager disk{file, 0, page_size, 0};
+    for (page_id_t pid = 0; pid < page_count; pid++) disk.extend();
+    {
+        Cache cache{disk, 10};
+        FreeList free_list{cache, nullpid};
+        auto pins = [&cache] {
+            return cache.stats().hits + cache.stats().misses;
+        };
+        for (page_id_t pid = 0; pid < page_count; pid++) {
+            const std::uint64_t before = pins();
+            free_list.push_back(pid);
+            assert(pins() - before <= 2);
+        }
+        for (page_id_t pid = page_count; pid-- > 0;) {
+            const std::uint64_t before = pins();
+            assert(free_list.pop_back() == pid);
+            assert(pins() - before <= 2);
+        }
+        assert(free_list.empty());
+    }
+    {
+        Cache cache{disk, 10};
+        {
+            FreeListBlock oldest{cache.pin(0), true};
+            for (page_id_t pid = 2; !oldest.full(); pid++)
+                oldest.push_back(pid);
+            oldest.set_next_block(1);
+            FreeListBlock newest{cache.pin(1), true};
+            for (page_id_t pid = 100; pid < 110; pid++) newest.push_back(pid);
+        }
+        FreeList free_list{cache, 0};
+        std::vector<page_id_t> popped;
+        while (!free_list.empty()) popped.push_back(free_list.pop_back());
+        std::sort(popped.begin(), popped.end());
+        std::vector<page_id_t> expected;
+        for (page_id_t pid = 0; pid < pids_per_block + 2; pid++)
+            expected.push_back(pid);
+        for (page_id_t pid = 100; pid < 110; pid++) expected.push_back(pid);
+        std::sort(expected.begin(), expected.end());
+        assert(popped == expected);
+    }
+    std::cout << "- test_chain passed" << std::endl;
+}
+
 int main() {
     test_constructor();
     test_push_pop();
+    test_chain();
     std::cout << "All tests passed." << std::endl;
     return 0;
 }
\ No newline at end of file
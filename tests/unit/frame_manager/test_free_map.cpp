@@ -0,0 +1,152 @@
+#include "frame_manager/free_map/free_map.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/cache/cache.hpp"
+#include "frame_manager/disk_manager/disk_manager.hpp"
+#include "frame_manager/disk_manager/memory_file.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/free_list/free_list.hpp"
+#include "frame_manager/free_map/free_map_block.hpp"
+
+using namespace minisql;
+
+/* Tests:
+ * - the File is extended while no page is free, without adding a block
+ * - freeing a page adds a block to cover it, and freeing it again does nothing
+ * - a page is allocated after near, else by extending the File if its end is
+ *   near, else before near, else the lowest free page is used */
+void test_allocate() {
+    const std::size_t page_size = 1024;
+    MemoryFile file{page_size * 1000};
+    DiskManager disk{file, 0, page_size, 0};
+    Cache cache{disk, 100};
+    FreeMap map{cache, disk, nullpid};
+    for (page_id_t pid = 0; pid < 200; pid++) assert(map.allocate() == pid);
+    assert(map.first_block() == nullpid);
+
+    for (page_id_t pid : {10, 20, 21, 150}) map.free(pid);
+    map.free(10);
+    assert(map.first_block() == 200 && disk.page_count() == 201);
+    assert(map.free_count() == 4);
+    assert(map.is_free(20) && !map.is_free(11) && !map.is_free(200));
+
+    assert(map.allocate(15) == 20);
+    assert(map.allocate(15) == 21);
+    assert(map.allocate(100) == 150);
+    assert(map.allocate(190) == 201);
+    map.free(120);
+    assert(map.allocate(130) == 120);
+    assert(map.allocate() == 10);
+    assert(map.allocate() == 202);
+    assert(map.free_count() == 0);
+    std::cout << "- test_allocate passed" << std::endl;
+}
+
+/* Tests:
+ * - freeing a batch of pages out of order adds blocks to cover them all, and
+ *   skips any already free */
+void test_free_batch() {
+    const std::size_t page_size = 1024;
+    const page_id_t block_pages = FreeMapBlock::capacity(page_size);
+    MemoryFile file{page_size * (block_pages + 100)};
+    DiskManager disk{file, 0, page_size, 0};
+    Cache cache{disk, 100};
+    FreeMap map{cache, disk, nullpid};
+    map.allocate_extent(block_pages + 10);
+    map.free(7);
+    std::vector<page_id_t> pids{block_pages + 3, 9, 7, 3, block_pages};
+    map.free(pids);
+    assert(map.free_count() == 5);
+    assert(disk.page_count() == block_pages + 12);
+    for (page_id_t pid : pids) assert(map.is_free(pid));
+    assert(map.allocate() == 3);
+    std::cout << "- test_free_batch passed" << std::endl;
+}
+
+/* Tests:
+ * - the lowest run of free pages long enough is allocated as an extent
+ * - a run at the end of the File is completed by extending it
+ * - the File is extended by the whole extent if there is no run */
+void test_allocate_extent() {
+    const std::size_t page_size = 1024;
+    MemoryFile file{page_size * 1000};
+    DiskManager disk{file, 0, page_size, 0};
+    Cache cache{disk, 100};
+    FreeMap map{cache, disk, nullpid};
+    assert(map.allocate_extent(100) == 0 && disk.page_count() == 100);
+
+    for (page_id_t pid : {10, 11, 12, 20, 21, 22, 23, 98, 99}) map.free(pid);
+    assert(map.allocate_extent(4) == 20);
+    assert(map.allocate_extent(3) == 10);
+    assert(map.allocate_extent(3) == 101 && disk.page_count() == 104);
+    map.free(102);
+    map.free(103);
+    assert(map.allocate_extent(4) == 102 && disk.page_count() == 106);
+    assert(map.free_count() == 2 && map.is_free(98) && map.is_free(99));
+    std::cout << "- test_allocate_extent passed" << std::endl;
+}
+
+/* Tests:
+ * - blocks are added at the end of the File as pages past them are freed
+ * - a map loaded from the chain finds the same free pages
+ * - loading from a page that is not a block throws a MagicException */
+void test_load() {
+    const std::size_t page_size = 1024;
+    const page_id_t block_pages = FreeMapBlock::capacity(page_size);
+    MemoryFile file{page_size * (block_pages * 2 + 100)};
+    DiskManager disk{file, 0, page_size, 0};
+    Cache cache{disk, 100};
+    FreeMap map{cache, disk, nullpid};
+    map.allocate_extent(block_pages * 2 + 10);
+    for (page_id_t pid : {5u, block_pages + 5, block_pages * 2 + 5})
+        map.free(pid);
+    assert(map.first_block() == block_pages * 2 + 10);
+    assert(disk.page_count() == block_pages * 2 + 13);
+
+    FreeMap loaded{cache, disk, map.first_block()};
+    assert(loaded.free_count() == 3);
+    assert(loaded.is_free(block_pages + 5) && !loaded.is_free(6));
+    assert(loaded.allocate() == 5);
+    assert(loaded.allocate(block_pages * 2) == block_pages * 2 + 5);
+
+    try {
+        FreeMap{cache, disk, 0};
+        assert(false);
+    }
+    catch (const MagicException&) {}
+    std::cout << "- test_load passed" << std::endl;
+}
+
+/* Tests:
+ * - a chain starting with a FreeListBlock, as written before the map, is
+ *   emptied into the map, its blocks included */
+void test_free_list() {
+    const std::size_t page_size = 1024;
+    MemoryFile file{page_size * 100};
+    DiskManager disk{file, 0, page_size, 0};
+    Cache cache{disk, 100};
+    for (int i = 0; i < 20; i++) disk.extend();
+    FreeList free_list{cache, nullpid};
+    for (page_id_t pid = 3; pid < 10; pid++) free_list.push_back(pid);
+
+    FreeMap map{cache, disk, free_list.first_free_list_block()};
+    assert(map.free_count() == 7 && map.first_block() == 20);
+    for (page_id_t pid = 3; pid < 10; pid++) assert(map.is_free(pid));
+    assert(map.allocate_extent(7) == 3);
+    std::cout << "- test_free_list passed" << std::endl;
+}
+
+int main() {
+    test_allocate();
+    test_free_batch();
+    test_allocate_extent();
+    test_load();
+    test_free_list();
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include "frame_manager/cache/replacer.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "minisql/options.hpp"
+
+using namespace minisql;
+
+/* Tests:
+ * - nothing is evicted until a Frame is unpinned
+ * - pinned Frames are never evicted
+ * - every unpinned Frame is evicted exactly once
+ * - Frames added by resize can be evicted
+ * - removed Frames are not evicted
+ * - evictable Frames are ranked in the reverse of the order they are evicted */
+void test_replacer(CachePolicy policy) {
+    const std::size_t capacity = 10;
+    std::unique_ptr<Replacer> replacer = make_replacer(policy, capacity);
+    assert(replacer->evict() == Replacer::npos);
+
+    for (std::size_t fid = 0; fid < capacity; fid++) replacer->unpin(fid);
+    assert(replacer->size() == capacity);
+    replacer->pin(3);
+    replacer->pin(3);
+    assert(replacer->size() == capacity - 1);
+
+    std::vector<std::size_t> ranked = replacer->ranked();
+    assert(ranked.size() == capacity - 1);
+    bool evicted[capacity] {};
+    for (std::size_t i = 0; i < capacity - 1; i++) {
+        const std::size_t fid = replacer->evict();
+        assert(fid != 3 && !evicted[fid]);
+        assert(fid == ranked[ranked.size() - 1 - i]);
+        evicted[fid] = true;
+    }
+    assert(replacer->ranked().empty());
+    assert(replacer->evict() == Replacer::npos);
+    assert(!replacer->size());
+
+    replacer->resize(capacity * 2);
+    replacer->unpin(capacity + 5);
+    assert(replacer->evict() == capacity + 5);
+
+    replacer->admit(1, 1);
+    replacer->unpin(1);
+    replacer->admit(2, 2);
+    replacer->unpin(2);
+    replacer->remove(1);
+    assert(replacer->size() == 1);
+    assert(replacer->evict() == 2);
+    assert(replacer->evict() == Replacer::npos);
+}
+
+/* Tests:
+ * - the least recently unpinned Frame is evicted first
+ * - unpinning a Frame again makes it the most recent */
+void test_lru() {
+    LRUReplacer replacer{4};
+    for (std::size_t fid = 0; fid < 4; fid++) replacer.unpin(fid);
+    replacer.pin(0);
+    replacer.unpin(0);
+    assert(replacer.evict() == 1);
+    assert(replacer.evict() == 2);
+    assert(replacer.evict() == 3);
+    assert(replacer.evict() == 0);
+    std::cout << "- test_lru passed" << std::endl;
+}
+
+/* Tests:
+ * - a sweep clears references before evicting
+ * - a Frame referenced since the last sweep gets a second chance */
+void test_clock() {
+    ClockReplacer replacer{4};
+    for (std::size_t fid = 0; fid < 4; fid++) replacer.unpin(fid);
+    assert(replacer.evict() == 0);
+    replacer.unpin(0);
+    replacer.unpin(2);
+    assert(replacer.evict() == 1);
+    assert(replacer.evict() == 3);
+    assert(replacer.evict() == 2);
+    assert(replacer.evict() == 0);
+    std::cout << "- test_clock passed" << std::endl;
+}
+
+/* Tests:
+ * - pages are admitted on probation and evicted from it first
+ * - a page referenced again soon after its eviction is admitted as hot
+ * - a scan of pages touched once never evicts the hot pages */
+void test_two_queue() {
+    const std::size_t capacity = 8;
+    TwoQueueReplacer replacer{capacity};
+    for (std::size_t fid = 0; fid < capacity; fid++) {
+        replacer.admit(fid, fid);
+        replacer.unpin(fid);
+    }
+    for (std::size_t fid = 0; fid < capacity; fid++)
+        assert(replacer.evict() == fid);
+
+    // Pages 4 to 7 are still remembered so are now admitted as hot.
+    for (std::size_t fid = 0; fid < capacity / 2; fid++) {
+        replacer.admit(fid, fid + capacity / 2);
+        replacer.unpin(fid);
+    }
+    page_id_t pid = 1000;
+    for (std::size_t fid = capacity / 2; fid < capacity; fid++) {
+        replacer.admit(fid, pid++);
+        replacer.unpin(fid);
+    }
+    for (int i = 0; i < 1000; i++) {
+        const std::size_t fid = replacer.evict();
+        assert(fid >= capacity / 2);
+        replacer.admit(fid, pid++);
+        replacer.unpin(fid);
+    }
+    std::cout << "- test_two_queue passed" << std::endl;
+}
+
+int main() {
+    test_replacer(CachePolicy::LRU);
+    test_replacer(CachePolicy::CLOCK);
+    test_replacer(CachePolicy::TWO_QUEUE);
+    std::cout << "- test_replacer passed" << std::endl;
+    test_lru();
+    test_clock();
+    test_two_queue();
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}
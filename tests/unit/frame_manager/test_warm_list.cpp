@@ -0,0 +1,81 @@
+#include "frame_manager/warm_list/warm_list.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include "exceptions/engine_exceptions.hpp"
+#include "frame_manager/disk_manager/memory_file.hpp"
+#include "frame_manager/disk_manager/page_id_t.hpp"
+#include "frame_manager/frame_manager.hpp"
+#include "headers.hpp"
+
+using namespace minisql;
+
+/* Tests:
+ * - saving no pages stores nothing
+ * - page_id_t's saved over several blocks are loaded back in order
+ * - loading frees the blocks for reuse
+ * - loading a page that is not a warm list block throws a MagicException */
+void test_save_load() {
+    const std::size_t page_size = 1024;
+    MemoryFile file{page_size * 100};
+    FrameManager fm{file, 0, page_size, 0, 100};
+    for (int i = 0; i < 10; i++) fm.allocate();
+    assert(warm_list::save(fm, {}) == nullpid);
+
+    const std::size_t per_block =
+        (page_size - WarmListBlockHeader::SIZE) / sizeof(page_id_t);
+    std::vector<page_id_t> pids;
+    for (std::size_t i = 0; i < per_block * 2 + 5; i++)
+        pids.push_back(static_cast<page_id_t>(i * 7 % 1000));
+    const page_id_t first_block = warm_list::save(fm, pids);
+    assert(fm.page_count() == 13);
+
+    // The free map takes a page of its own once the blocks are freed
+    assert(warm_list::load(fm, first_block) == pids);
+    assert(fm.page_count() == 14 && fm.free_page_count() == 3);
+    for (int i = 0; i < 3; i++) fm.allocate();
+    assert(fm.page_count() == 14);
+
+    try {
+        warm_list::load(fm, 0);
+        assert(false);
+    }
+    catch (const MagicException&) {}
+    std::cout << "- test_save_load passed" << std::endl;
+}
+
+/* Tests:
+ * - warming up reads the pages in, so that pinning them hits
+ * - only as many pages as fit in the cache are read, those listed first */
+void test_warm_up() {
+    const std::size_t page_size = 1024;
+    MemoryFile file{page_size * 100};
+    {
+        FrameManager fm{file, 0, page_size, 0, 100};
+        for (page_id_t pid = 0; pid < 100; pid++)
+            fm.allocate().write<page_id_t>(0, pid + 1);
+        fm.flush_all();
+    }
+    FrameManager fm{file, 0, page_size, 100, 10};
+    std::vector<page_id_t> pids;
+    for (page_id_t pid = 60; pid > 0; pid -= 3) pids.push_back(pid);
+    const WarmUpStats stats = warm_list::warm_up(fm, pids);
+    assert(stats.pages == 10);
+
+    for (std::size_t i = 0; i < 10; i++)
+        assert(fm.pin(pids[i]).view<page_id_t>(0) == pids[i] + 1);
+    assert(fm.cache_stats().hits == 10 && fm.cache_stats().misses == 0);
+    assert(fm.pin(pids[10]).view<page_id_t>(0) == pids[10] + 1);
+    assert(fm.cache_stats().misses == 1);
+    std::cout << "- test_warm_up passed" << std::endl;
+}
+
+int main() {
+    test_save_load();
+    test_warm_up();
+    std::cout << "All tests passed." << std::endl;
+    return 0;
+}